@@ -0,0 +1,22 @@
+# Fails if a per ISA kernel object defines a global symbol outside its own namespace. Such a symbol, e.g. an
+# out of line std::min, could be picked by the linker for the whole program and run AVX code on any CPU.
+# Usage: cmake -DNM=<nm> -DLEVEL=<level> -DOBJECTS=<objects> -P CheckKernelSymbols.cmake
+
+execute_process(COMMAND ${NM} -g -C --defined-only ${OBJECTS}
+    OUTPUT_VARIABLE symbols
+    RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${NM} failed on ${OBJECTS}")
+endif()
+
+string(REPLACE "\n" ";" symbols "${symbols}")
+foreach(line ${symbols})
+    # Lines look like "<address> <type> <name>", file headers end with a colon
+    if(NOT line MATCHES "^[0-9a-fA-F]* +[A-Za-z] +(.*)$")
+        continue()
+    endif()
+    set(name "${CMAKE_MATCH_1}")
+    if(NOT name MATCHES "^Dispatch::detail::${LEVEL}Kernels$" AND NOT name MATCHES "::${LEVEL}::")
+        message(FATAL_ERROR "Kernel object for ${LEVEL} exports ${name}")
+    endif()
+endforeach()
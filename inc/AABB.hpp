@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Vector2.hpp"
+
+template <typename T>
+struct AABB2
+{
+    Vector2<T> min, max;
+
+    /// @brief Default constructor
+    constexpr AABB2()
+        : min(), max()
+    {
+    }
+
+    /// @brief Parameterized constructor
+    /// @param min_ Corner with the smallest coordinates
+    /// @param max_ Corner with the largest coordinates
+    constexpr AABB2(Vector2<T> min_, Vector2<T> max_)
+        : min(min_), max(max_)
+    {
+    }
+
+    /// @brief Returns the width and height of the AABB2
+    [[nodiscard]] constexpr Vector2<T> getSize() const
+    {
+        return Vector2<T>(max.x - min.x, max.y - min.y);
+    }
+
+    /// @brief Returns the center of the AABB2
+    [[nodiscard]] constexpr Vector2<T> getCenter() const
+    {
+        return Vector2<T>((min.x + max.x) / 2, (min.y + max.y) / 2);
+    }
+
+    /// @brief Returns whether the point lies inside or on the border of the AABB2
+    [[nodiscard]] constexpr bool contains(const Vector2<T> &p) const
+    {
+        return min.x <= p.x && p.x <= max.x && min.y <= p.y && p.y <= max.y;
+    }
+
+    /// @brief Returns whether both boxes overlap, touching borders count as overlap
+    [[nodiscard]] constexpr bool overlaps(const AABB2<T> &other) const
+    {
+        return min.x <= other.max.x && other.min.x <= max.x && min.y <= other.max.y && other.min.y <= max.y;
+    }
+
+    /// @brief Returns a Copy of the AABB2 translated by offset
+    [[nodiscard]] constexpr AABB2<T> getTranslated(Vector2<T> offset) const
+    {
+        return AABB2<T>(Vector2<T>(min.x + offset.x, min.y + offset.y), Vector2<T>(max.x + offset.x, max.y + offset.y));
+    }
+};
+
+/// @brief Equality operator
+template <typename Ta, typename Tb>
+constexpr bool operator==(const AABB2<Ta> &a, const AABB2<Tb> &b)
+{
+    return a.min == b.min && a.max == b.max;
+}
+
+// Common Typedefs
+typedef AABB2<float> AABB2f;
+typedef AABB2<double> AABB2d;
+typedef AABB2<int> AABB2i;
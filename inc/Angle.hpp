@@ -82,90 +82,90 @@ public:
 }
 
 /// @brief Equality Operator
-[[nodiscard]] bool operator==(const Angle &a, const Angle &b)
+[[nodiscard]] inline bool operator==(const Angle &a, const Angle &b)
 {
     return a.getRadians() == b.getRadians();
 }
 
 /// @brief Inequality Operator
-[[nodiscard]] bool operator!=(const Angle &a, const Angle &b)
+[[nodiscard]] inline bool operator!=(const Angle &a, const Angle &b)
 {
     return a.getRadians() != b.getRadians();
 }
 
 /// @brief Less Operator
-[[nodiscard]] bool operator<(const Angle &a, const Angle &b)
+[[nodiscard]] inline bool operator<(const Angle &a, const Angle &b)
 {
     return a.getRadians() < b.getRadians();
 }
 
 /// @brief Greater Operator
-[[nodiscard]] bool operator>(const Angle &a, const Angle &b)
+[[nodiscard]] inline bool operator>(const Angle &a, const Angle &b)
 {
     return a.getRadians() > b.getRadians();
 }
 
 /// @brief Less-or-equal Operator
-[[nodiscard]] bool operator<=(const Angle &a, const Angle &b)
+[[nodiscard]] inline bool operator<=(const Angle &a, const Angle &b)
 {
     return a.getRadians() <= b.getRadians();
 }
 
 /// @brief Greater-or-equal Operator
-[[nodiscard]] bool operator>=(const Angle &a, const Angle &b)
+[[nodiscard]] inline bool operator>=(const Angle &a, const Angle &b)
 {
     return a.getRadians() >= b.getRadians();
 }
 
 /// @brief Addition Operator
-[[nodiscard]] Angle operator+(const Angle &a, const Angle &b)
+[[nodiscard]] inline Angle operator+(const Angle &a, const Angle &b)
 {
     return radians(a.getRadians() + b.getRadians());
 }
 /// @brief Subtraction Operator
-[[nodiscard]] Angle operator-(const Angle &a, const Angle &b)
+[[nodiscard]] inline Angle operator-(const Angle &a, const Angle &b)
 {
     return radians(a.getRadians() - b.getRadians());
 }
 /// @brief Subtraction Operator
-[[nodiscard]] Angle operator-(const Angle &a)
+[[nodiscard]] inline Angle operator-(const Angle &a)
 {
     return radians(-a.getRadians());
 }
 /// @brief Addition assignment Operator
-Angle &operator+=(Angle &a, const Angle &b)
+inline Angle &operator+=(Angle &a, const Angle &b)
 {
     return a = a + b;
 }
 /// @brief Subtraction assignment Operator
-Angle &operator-=(Angle &a, const Angle &b)
+inline Angle &operator-=(Angle &a, const Angle &b)
 {
     return a = a - b;
 }
 
 /// @brief Multiplication Operator (Element-wise)
-[[nodiscard]] Angle operator*(const Angle &a, const Angle &b)
+[[nodiscard]] inline Angle operator*(const Angle &a, const Angle &b)
 {
     return radians(a.getRadians() * b.getRadians());
 }
 /// @brief Division Operator
-[[nodiscard]] Angle operator/(const Angle &a, const Angle &b)
+[[nodiscard]] inline Angle operator/(const Angle &a, const Angle &b)
 {
     return radians(a.getRadians() / b.getRadians());
 }
 /// @brief Multiplication Assignment Operator
-Angle &operator*=(Angle &a, const Angle &b)
+inline Angle &operator*=(Angle &a, const Angle &b)
 {
     return a = a * b;
 }
 /// @brief Division Assignment Operator
-Angle &operator/=(Angle &a, const Angle &b)
+inline Angle &operator/=(Angle &a, const Angle &b)
 {
     return a = a / b;
 }
 
 /// @brief Modulo Operator
-[[deprecated("NYI")]] [[nodiscard]] Angle operator%(const Angle &a, const Angle &b)
+[[deprecated("NYI")]] [[nodiscard]] inline Angle operator%(const Angle &a, const Angle &b)
 {
     const float ret = a.getRadians() - std::ceil(a.getRadians() / 2.f / std::numbers::pi) * 2.f * std::numbers::pi;
     if (ret >= 0.f)
@@ -175,28 +175,28 @@ Angle &operator/=(Angle &a, const Angle &b)
 }
 
 /// @brief Modulo Assignment Operator
-Angle &operator%=(Angle &a, const Angle &b)
+inline Angle &operator%=(Angle &a, const Angle &b)
 {
     return a = a % b;
 }
 
 /// @brief Literal Operator for degrees
-[[nodiscard]] Angle operator""_deg(long double angle)
+[[nodiscard]] inline Angle operator""_deg(long double angle)
 {
     return degrees(angle);
 }
 /// @brief Literal Operator for degrees
-[[nodiscard]] Angle operator""_deg(unsigned long long angle)
+[[nodiscard]] inline Angle operator""_deg(unsigned long long angle)
 {
     return degrees(angle);
 }
 /// @brief Literal Operator for radians
-[[nodiscard]] Angle operator""_rad(long double angle)
+[[nodiscard]] inline Angle operator""_rad(long double angle)
 {
     return radians(angle);
 }
 /// @brief Literal Operator for radians
-[[nodiscard]] Angle operator""_rad(unsigned long long angle)
+[[nodiscard]] inline Angle operator""_rad(unsigned long long angle)
 {
     return radians(angle);
 }
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Vector2.hpp"
+#include "AABB.hpp"
+#include "Parallel.hpp"
+#include "Serialization.hpp"
+#include "KernelMath.hpp"
+
+#ifdef VECTOR2_DISPATCH
+#include "Dispatch.hpp"
+#endif
+
+namespace Binning
+{
+    /// @brief How a point distributes its weight over the grid
+    enum class Splat
+    {
+        Nearest, ///< All weight goes to the cell containing the point
+        Bilinear ///< Weight is shared by the four cells whose centers surround the point
+    };
+
+    namespace detail
+    {
+        inline namespace VECTOR2_KERNEL_NAMESPACE
+        {
+            // Clamping before the conversion makes the truncation a floor and keeps NaN in cell 0, since
+            // max(0, NaN) returns 0. Both are plain min/max, so the loop compiles to packed instructions.
+            // The interleaved x/y loads are only vectorized by GCC's dynamic cost model, which needs -O3.
+            template <typename T>
+            void cellIndexKernel(const Vector2<T> *__restrict points, std::uint32_t *__restrict cells, std::size_t begin, std::size_t end, T minX, T minY, T scaleX, T scaleY, T maxColumn, T maxRow, std::uint32_t columns)
+            {
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    const T x = KernelMath::max(T(0), KernelMath::min((points[i].x - minX) * scaleX, maxColumn));
+                    const T y = KernelMath::max(T(0), KernelMath::min((points[i].y - minY) * scaleY, maxRow));
+                    cells[i] = std::uint32_t(std::int32_t(y)) * columns + std::uint32_t(std::int32_t(x));
+                }
+            }
+        }
+
+        /// @brief Points handled per call of the cell index kernel, the indices of one block stay in L1
+        constexpr std::size_t blockSize = 1024;
+    }
+
+    /// @brief Regular 2D grid over a rectangle that accumulates point counts or weights per cell
+    /// @details Large inputs are split across threads that each accumulate into a private copy of the grid,
+    /// which are summed afterwards, so no atomics are needed. Every thread gets at least as many points as the
+    /// grid has cells, so the copies never cost more than the binning itself. Points outside the bounds are
+    /// clamped into the border cells.
+    template <typename T, typename C = double>
+    class Histogram2
+    {
+        static_assert(std::is_floating_point_v<T>, "Histogram2 needs floating point coordinates");
+
+    private:
+        AABB2<T> _bounds;
+        std::uint32_t _columns = 0, _rows = 0;
+        Vector2<T> _scale;
+        std::vector<C> _cells;
+        C _total = C(0);
+
+        void cellIndices(const Vector2<T> *points, std::uint32_t *cells, std::size_t n) const
+        {
+            auto kernel = detail::cellIndexKernel<T>;
+#ifdef VECTOR2_DISPATCH
+            if constexpr (std::is_same_v<T, float>)
+                kernel = Dispatch::kernels().cellIndices;
+#endif
+            kernel(points, cells, 0, n, _bounds.min.x, _bounds.min.y, _scale.x, _scale.y, T(_columns - 1), T(_rows - 1), _columns);
+        }
+
+        /// @return Sum of the added weights
+        C addNearest(std::span<const Vector2<T>> points, std::span<const C> weights, std::size_t begin, std::size_t end, C *grid) const
+        {
+            C total = C(0);
+            std::uint32_t cells[detail::blockSize];
+            for (std::size_t block = begin; block < end; block += detail::blockSize)
+            {
+                const std::size_t n = std::min(detail::blockSize, end - block);
+                cellIndices(points.data() + block, cells, n);
+                if (weights.empty())
+                {
+                    for (std::size_t k = 0; k < n; k++)
+                        grid[cells[k]] += C(1);
+                    total += C(n);
+                }
+                else
+                    for (std::size_t k = 0; k < n; k++)
+                    {
+                        grid[cells[k]] += weights[block + k];
+                        total += weights[block + k];
+                    }
+            }
+            return total;
+        }
+
+        /// @return Sum of the added weights
+        C addBilinear(std::span<const Vector2<T>> points, std::span<const C> weights, std::size_t begin, std::size_t end, C *grid) const
+        {
+            C total = C(0);
+            // Coordinates relative to the cell centers, clamped so that the border cells keep all the weight
+            // of points beyond them and the total weight is preserved
+            const T maxColumn = T(_columns - 1), maxRow = T(_rows - 1);
+            for (std::size_t i = begin; i < end; i++)
+            {
+                const T u = std::max(T(0), std::min((points[i].x - _bounds.min.x) * _scale.x - T(0.5), maxColumn));
+                const T v = std::max(T(0), std::min((points[i].y - _bounds.min.y) * _scale.y - T(0.5), maxRow));
+                const std::uint32_t x0 = std::uint32_t(u), y0 = std::uint32_t(v);
+                const std::uint32_t x1 = std::min(x0 + 1, _columns - 1), y1 = std::min(y0 + 1, _rows - 1);
+                const C fx = C(u - T(x0)), fy = C(v - T(y0));
+                const C w = weights.empty() ? C(1) : weights[i];
+
+                grid[y0 * _columns + x0] += w * (1 - fx) * (1 - fy);
+                grid[y0 * _columns + x1] += w * fx * (1 - fy);
+                grid[y1 * _columns + x0] += w * (1 - fx) * fy;
+                grid[y1 * _columns + x1] += w * fx * fy;
+                total += w;
+            }
+            return total;
+        }
+
+        void accumulate(std::span<const Vector2<T>> points, std::span<const C> weights, Splat splat)
+        {
+            if (_cells.empty())
+                throw std::runtime_error("Binning into an empty grid");
+            if (!weights.empty() && weights.size() != points.size())
+                throw std::runtime_error("Number of weights and points differ");
+
+            const std::size_t minChunk = std::max<std::size_t>(1 << 15, _cells.size());
+            const std::size_t chunks = Parallel::chunkCount(points.size(), minChunk);
+            std::vector<std::vector<C>> partial(chunks - 1);
+            std::vector<C> totals(chunks, C(0));
+
+            Parallel::forChunks(points.size(), minChunk, [&](std::size_t begin, std::size_t end, std::size_t chunk)
+                                {
+                C *grid = _cells.data();
+                if (chunk > 0)
+                {
+                    partial[chunk - 1].assign(_cells.size(), C(0));
+                    grid = partial[chunk - 1].data();
+                }
+                totals[chunk] = splat == Splat::Bilinear ? addBilinear(points, weights, begin, end, grid)
+                                                         : addNearest(points, weights, begin, end, grid); });
+
+            for (const C total : totals)
+                _total += total;
+
+            if (!partial.empty())
+                Parallel::forChunks(_cells.size(), 1 << 14, [&](std::size_t begin, std::size_t end, std::size_t)
+                                    {
+                    for (const std::vector<C> &grid : partial)
+                        for (std::size_t i = begin; i < end; i++)
+                            _cells[i] += grid[i]; });
+        }
+
+    public:
+        /// @brief Default constructor, an empty grid
+        Histogram2()
+        {
+        }
+
+        /// @brief Constructs a grid of columns x rows cells covering bounds, all cells are zero
+        Histogram2(const AABB2<T> &bounds, std::uint32_t columns, std::uint32_t rows)
+            : _bounds(bounds), _columns(columns), _rows(rows)
+        {
+            const Vector2<T> size = bounds.getSize();
+            if (columns == 0 || rows == 0 || !(size.x > 0) || !(size.y > 0))
+                throw std::runtime_error("Invalid grid");
+            if (std::uint64_t(columns) * rows > std::numeric_limits<std::uint32_t>::max())
+                throw std::runtime_error("Grid has too many cells");
+            // The kernels clamp to columns - 1 and rows - 1 in T, which has to hold them exactly
+            constexpr std::uint64_t maxSize = std::uint64_t(1) << std::min(std::numeric_limits<T>::digits, 63);
+            if (columns > maxSize || rows > maxSize)
+                throw std::runtime_error("Grid too large for the coordinate type");
+
+            _scale = Vector2<T>(T(columns) / size.x, T(rows) / size.y);
+            _cells.assign(std::size_t(columns) * rows, C(0));
+        }
+
+        /// @brief Returns the area covered by the grid
+        [[nodiscard]] const AABB2<T> &getBounds() const
+        {
+            return _bounds;
+        }
+
+        /// @brief Returns the number of columns
+        [[nodiscard]] std::uint32_t getColumns() const
+        {
+            return _columns;
+        }
+
+        /// @brief Returns the number of rows
+        [[nodiscard]] std::uint32_t getRows() const
+        {
+            return _rows;
+        }
+
+        /// @brief Returns all cells in row major order
+        [[nodiscard]] std::span<const C> getCells() const
+        {
+            return _cells;
+        }
+
+        /// @brief Returns the value of one cell
+        [[nodiscard]] C getCell(std::uint32_t column, std::uint32_t row) const
+        {
+            return _cells[std::size_t(row) * _columns + column];
+        }
+
+        /// @brief Returns the center of one cell
+        [[nodiscard]] Vector2<T> getCellCenter(std::uint32_t column, std::uint32_t row) const
+        {
+            return Vector2<T>(_bounds.min.x + (T(column) + T(0.5)) / _scale.x, _bounds.min.y + (T(row) + T(0.5)) / _scale.y);
+        }
+
+        /// @brief Returns the row major index of the cell containing p, points outside are clamped to the border
+        [[nodiscard]] std::uint32_t cellOf(const Vector2<T> &p) const
+        {
+            std::uint32_t cell;
+            detail::cellIndexKernel<T>(&p, &cell, 0, 1, _bounds.min.x, _bounds.min.y, _scale.x, _scale.y, T(_columns - 1), T(_rows - 1), _columns);
+            return cell;
+        }
+
+        /// @brief Writes the row major cell index of every point to cells, which has to be at least as large as points
+        void cellOf(std::span<const Vector2<T>> points, std::span<std::uint32_t> cells) const
+        {
+            if (cells.size() < points.size())
+                throw std::runtime_error("Output span too small");
+
+            Parallel::forChunks(points.size(), 1 << 14, [&](std::size_t begin, std::size_t end, std::size_t)
+                                { cellIndices(points.data() + begin, cells.data() + begin, end - begin); });
+        }
+
+        /// @brief Returns the sum of everything added, kept up to date by every add, so this is O(1)
+        [[nodiscard]] C getTotal() const
+        {
+            return _total;
+        }
+
+        /// @brief Returns the normalized density of one cell, the cell value divided by the total and the cell area
+        [[nodiscard]] double getDensity(std::uint32_t column, std::uint32_t row) const
+        {
+            return _total == C(0) ? 0.0 : double(getCell(column, row)) * double(_scale.x) * double(_scale.y) / double(_total);
+        }
+
+        /// @brief Writes the normalized density of every cell in row major order to densities, which has to be at
+        /// least as large as getCells()
+        void getDensities(std::span<double> densities) const
+        {
+            if (densities.size() < _cells.size())
+                throw std::runtime_error("Output span too small");
+
+            const double scale = _total == C(0) ? 0.0 : double(_scale.x) * double(_scale.y) / double(_total);
+            for (std::size_t i = 0; i < _cells.size(); i++)
+                densities[i] = double(_cells[i]) * scale;
+        }
+
+        /// @brief Adds one count per point
+        void add(std::span<const Vector2<T>> points, Splat splat = Splat::Nearest)
+        {
+            accumulate(points, {}, splat);
+        }
+
+        /// @brief Adds weights[i] for points[i], both spans need the same size
+        void add(std::span<const Vector2<T>> points, std::span<const C> weights, Splat splat = Splat::Nearest)
+        {
+            accumulate(points, weights, splat);
+        }
+
+        /// @brief Adds one count per vector read from is, which is parsed chunk by chunk as by Serial::readChunks
+        /// @details Only one chunk is held in memory at a time, so the input can be larger than the available RAM.
+        /// @return Number of points added
+        std::size_t addFrom(std::istream &is, Splat splat = Splat::Nearest, std::size_t chunkBytes = 1 << 20)
+        {
+            std::size_t count = 0;
+            Serial::readChunks<T>(is, [&](std::span<const Vector2<T>> chunk)
+                                  {
+                add(chunk, splat);
+                count += chunk.size(); },
+                                  chunkBytes);
+            return count;
+        }
+
+        /// @brief Adds the cells of a grid with the same bounds and shape
+        void merge(const Histogram2 &other)
+        {
+            if (!(other._bounds == _bounds) || other._columns != _columns || other._rows != _rows)
+                throw std::runtime_error("Merging histograms of different grids");
+
+            for (std::size_t i = 0; i < _cells.size(); i++)
+                _cells[i] += other._cells[i];
+            _total += other._total;
+        }
+
+        /// @brief Sets all cells to zero
+        void clear()
+        {
+            std::fill(_cells.begin(), _cells.end(), C(0));
+            _total = C(0);
+        }
+    };
+}
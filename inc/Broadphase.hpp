@@ -0,0 +1,117 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "AABB.hpp"
+#include "Parallel.hpp"
+
+namespace Broadphase
+{
+    /// @brief Pair of box indices, always first < second
+    using Pair = std::pair<std::uint32_t, std::uint32_t>;
+
+    /// @brief Incremental sort-and-sweep along the x axis
+    /// @details The order of the boxes is kept between calls to update(). Moving boxes only slightly reorder it,
+    /// so it is repaired with an insertion sort in close to linear time instead of sorting from scratch. Frames
+    /// that reorder too much, e.g. after the boxes were permuted, fall back to a parallel sort.
+    template <typename T>
+    class SortAndSweep
+    {
+    private:
+        std::vector<std::uint32_t> _order;
+        std::vector<T> _minX, _maxX, _minY, _maxY;
+        std::vector<std::vector<Pair>> _partial;
+        std::vector<Pair> _pairs;
+
+        void sortFromScratch(std::span<const AABB2<T>> boxes)
+        {
+            const std::size_t n = boxes.size();
+            Parallel::sort(_order.begin(), _order.end(), [boxes](std::uint32_t a, std::uint32_t b)
+                           { return boxes[a].min.x < boxes[b].min.x; });
+            _minX.resize(n);
+            for (std::size_t k = 0; k < n; k++)
+                _minX[k] = boxes[_order[k]].min.x;
+        }
+
+        void sortOrder(std::span<const AABB2<T>> boxes)
+        {
+            const std::size_t n = boxes.size();
+
+            if (_order.size() != n)
+            {
+                _order.resize(n);
+                std::iota(_order.begin(), _order.end(), 0u);
+                sortFromScratch(boxes);
+                return;
+            }
+
+            for (std::size_t k = 0; k < n; k++)
+                _minX[k] = boxes[_order[k]].min.x;
+
+            // The repair is quadratic if the boxes were permuted, e.g. by swap-removing bodies, so it gives up
+            // after about n log n moves. _order stays a permutation at any point and is then sorted from scratch.
+            const std::size_t maxMoves = n * (std::bit_width(n) + 1);
+            std::size_t moves = 0;
+            for (std::size_t k = 1; k < n; k++)
+            {
+                const T key = _minX[k];
+                const std::uint32_t index = _order[k];
+                std::size_t m = k;
+                for (; m > 0 && _minX[m - 1] > key; m--)
+                {
+                    _minX[m] = _minX[m - 1];
+                    _order[m] = _order[m - 1];
+                }
+                _minX[m] = key;
+                _order[m] = index;
+
+                moves += k - m;
+                if (moves > maxMoves)
+                {
+                    sortFromScratch(boxes);
+                    return;
+                }
+            }
+        }
+
+    public:
+        /// @brief Returns all pairs of overlapping boxes, touching borders count as overlap
+        /// @details The returned buffer is reused and stays valid until the next call.
+        const std::vector<Pair> &update(std::span<const AABB2<T>> boxes)
+        {
+            const std::size_t n = boxes.size();
+            sortOrder(boxes);
+
+            _maxX.resize(n);
+            _minY.resize(n);
+            _maxY.resize(n);
+            for (std::size_t k = 0; k < n; k++)
+            {
+                const AABB2<T> &box = boxes[_order[k]];
+                _maxX[k] = box.max.x;
+                _minY[k] = box.min.y;
+                _maxY[k] = box.max.y;
+            }
+
+            _partial.resize(Parallel::chunkCount(n, 1 << 12));
+            Parallel::forChunks(n, 1 << 12, [this, n](std::size_t begin, std::size_t end, std::size_t chunk)
+                                {
+                std::vector<Pair> &out = _partial[chunk];
+                out.clear();
+                for (std::size_t k = begin; k < end; k++)
+                    for (std::size_t m = k + 1; m < n && _minX[m] <= _maxX[k]; m++)
+                        if (_minY[m] <= _maxY[k] && _minY[k] <= _maxY[m])
+                            out.emplace_back(std::min(_order[k], _order[m]), std::max(_order[k], _order[m])); });
+
+            _pairs.clear();
+            for (const std::vector<Pair> &p : _partial)
+                _pairs.insert(_pairs.end(), p.begin(), p.end());
+            return _pairs;
+        }
+    };
+}
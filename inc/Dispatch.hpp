@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+template <typename T>
+struct Vector2;
+
+/// @brief Runtime selection of the batch kernels compiled into the vector2 library
+/// @details The library compiles src/Kernels.cpp once per ISA level. The level is detected once via cpuid
+/// on first use and can be lowered for testing with the environment variable VECTOR2_ISA
+/// (baseline, x86-64-v3 or x86-64-v4). Headers route their float kernels through kernels() whenever
+/// VECTOR2_DISPATCH is defined, which linking the vector2 target does automatically.
+namespace Dispatch
+{
+    enum class IsaLevel
+    {
+        Baseline,
+        X86_64_v3, ///< AVX2, FMA, BMI1/2
+        X86_64_v4  ///< AVX-512 F/BW/CD/DQ/VL
+    };
+
+    using StepKernel = void (*)(float *, float *, float *, float *, const float *, const float *, std::size_t, std::size_t, float, float, float);
+    using DriftKernel = void (*)(float *, float *, float *, float *, const float *, const float *, std::size_t, std::size_t, float);
+    using KickKernel = void (*)(float *, float *, const float *, const float *, std::size_t, std::size_t, float, float, float);
+    using CellKernel = void (*)(const Vector2<float> *, std::uint32_t *, std::size_t, std::size_t, float, float, float, float, float, float, std::uint32_t);
+
+    /// @brief Kernels compiled for one ISA level
+    struct KernelTable
+    {
+        IsaLevel level;
+        StepKernel euler, eulerClamped;
+        StepKernel semiImplicitEuler, semiImplicitEulerClamped;
+        DriftKernel verletPositions;
+        KickKernel verletVelocities, verletVelocitiesClamped;
+        CellKernel cellIndices;
+    };
+
+    /// @brief Returns the name used for level by VECTOR2_ISA
+    [[nodiscard]] const char *isaName(IsaLevel level);
+
+    /// @brief Parses a level name as used by VECTOR2_ISA ("baseline", "x86-64-v3"/"v3", "x86-64-v4"/"v4")
+    [[nodiscard]] std::optional<IsaLevel> parseIsa(std::string_view name);
+
+    /// @brief Returns the highest level that is both compiled in and supported by this CPU and OS
+    [[nodiscard]] IsaLevel detectIsa();
+
+    /// @brief Returns the level VECTOR2_ISA set to requested selects on a CPU supporting detected
+    /// @details The override can only lower the level, a higher one than detected is clamped to detected.
+    /// Throws for a name parseIsa() does not know, so a typo does not silently test the default level.
+    [[nodiscard]] IsaLevel selectIsa(std::string_view requested, IsaLevel detected);
+
+    /// @brief Returns the level in use: detectIsa(), or selectIsa() of VECTOR2_ISA if that is set. Decided once
+    [[nodiscard]] IsaLevel activeIsa();
+
+    /// @brief Returns the kernels for level, which must not be above detectIsa()
+    [[nodiscard]] const KernelTable &kernels(IsaLevel level);
+
+    /// @brief Returns the kernels for activeIsa()
+    [[nodiscard]] const KernelTable &kernels();
+}
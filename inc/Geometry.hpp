@@ -0,0 +1,230 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "Vector2.hpp"
+#include "Parallel.hpp"
+
+namespace Geometry
+{
+    /// @brief Turn direction of three points, or winding direction of a polygon
+    enum class Orientation
+    {
+        Clockwise = -1,
+        Collinear = 0,
+        CounterClockwise = 1
+    };
+
+    namespace detail
+    {
+        /// @brief Error-free sum, x + y == a + b exactly
+        inline void twoSum(double a, double b, double &x, double &y)
+        {
+            x = a + b;
+            const double bv = x - a;
+            const double av = x - bv;
+            y = (a - av) + (b - bv);
+        }
+
+        /// @brief Error-free product, x + y == a * b exactly
+        inline void twoProduct(double a, double b, double &x, double &y)
+        {
+            x = a * b;
+            y = std::fma(a, b, -x);
+        }
+
+        /// @brief Nonoverlapping floating point expansion, the exact value is the sum of all components
+        struct Expansion
+        {
+            std::array<double, 32> e;
+            std::size_t size = 0;
+
+            /// @brief Adds b exactly (Shewchuk's Grow-Expansion with zero elimination)
+            void add(double b)
+            {
+                double q = b;
+                std::size_t k = 0;
+                for (std::size_t i = 0; i < size; i++)
+                {
+                    double h;
+                    twoSum(q, e[i], q, h);
+                    if (h != 0.0)
+                        e[k++] = h;
+                }
+                e[k++] = q;
+                size = k;
+            }
+
+            /// @brief Sign of the exact value, given by the largest nonzero component
+            int sign() const
+            {
+                for (std::size_t i = size; i-- > 0;)
+                    if (e[i] != 0.0)
+                        return e[i] > 0.0 ? 1 : -1;
+                return 0;
+            }
+        };
+
+        /// @brief Exact sign of (ax - cx) * (by - cy) - (ay - cy) * (bx - cx)
+        inline int orient2dExact(double ax, double ay, double bx, double by, double cx, double cy)
+        {
+            double acx[2], bcy[2], acy[2], bcx[2];
+            twoSum(ax, -cx, acx[0], acx[1]);
+            twoSum(by, -cy, bcy[0], bcy[1]);
+            twoSum(ay, -cy, acy[0], acy[1]);
+            twoSum(bx, -cx, bcx[0], bcx[1]);
+
+            Expansion det;
+            for (int i = 0; i < 2; i++)
+                for (int j = 0; j < 2; j++)
+                {
+                    double hi, lo;
+                    twoProduct(acx[i], bcy[j], hi, lo);
+                    det.add(hi);
+                    det.add(lo);
+                    twoProduct(acy[i], bcx[j], hi, lo);
+                    det.add(-hi);
+                    det.add(-lo);
+                }
+            return det.sign();
+        }
+    }
+
+    /// @brief Returns whether c lies to the left of (CounterClockwise), to the right of (Clockwise) or on the line through a and b
+    /// @details The determinant is evaluated in double precision and only recomputed exactly if it is smaller than
+    /// its worst case rounding error, so the result is exact while the common case stays as cheap as crossProduct.
+    template <typename T>
+    [[nodiscard]] Orientation orient2d(const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c)
+    {
+        constexpr double epsilon = std::numeric_limits<double>::epsilon() / 2;
+        constexpr double errBound = (3.0 + 16.0 * epsilon) * epsilon;
+
+        const double ax = a.x, ay = a.y, bx = b.x, by = b.y, cx = c.x, cy = c.y;
+        const double detLeft = (ax - cx) * (by - cy);
+        const double detRight = (ay - cy) * (bx - cx);
+        const double det = detLeft - detRight;
+
+        if (std::abs(det) >= errBound * (std::abs(detLeft) + std::abs(detRight)))
+            return det > 0 ? Orientation::CounterClockwise : (det < 0 ? Orientation::Clockwise : Orientation::Collinear);
+
+        return static_cast<Orientation>(detail::orient2dExact(ax, ay, bx, by, cx, cy));
+    }
+
+    /// @brief Returns the signed area of a simple polygon, positive if its vertices are in counter-clockwise order
+    template <typename T>
+    [[nodiscard]] double signedArea(std::span<const Vector2<T>> polygon)
+    {
+        const std::size_t n = polygon.size();
+        if (n < 3)
+            return 0.0;
+
+        // Independent partial sums so the shoelace terms are not serialized on a single accumulator
+        double sum[4] = {0.0, 0.0, 0.0, 0.0};
+        std::size_t i = 0;
+        for (; i + 4 < n; i += 4)
+            for (std::size_t k = 0; k < 4; k++)
+                sum[k] += double(polygon[i + k].x) * polygon[i + k + 1].y - double(polygon[i + k + 1].x) * polygon[i + k].y;
+        for (; i + 1 < n; i++)
+            sum[0] += double(polygon[i].x) * polygon[i + 1].y - double(polygon[i + 1].x) * polygon[i].y;
+        sum[0] += double(polygon[n - 1].x) * polygon[0].y - double(polygon[0].x) * polygon[n - 1].y;
+
+        return 0.5 * ((sum[0] + sum[1]) + (sum[2] + sum[3]));
+    }
+
+    /// @brief Returns the winding direction of a simple polygon
+    template <typename T>
+    [[nodiscard]] Orientation orientation(std::span<const Vector2<T>> polygon)
+    {
+        const double area = signedArea(polygon);
+        return area > 0 ? Orientation::CounterClockwise : (area < 0 ? Orientation::Clockwise : Orientation::Collinear);
+    }
+
+    /// @brief Tests many points against a single polygon using the crossing number (even-odd) rule
+    /// @param inside Receives 1 for every point inside the polygon and 0 otherwise, must be as large as points
+    template <typename T>
+    void contains(std::span<const Vector2<T>> polygon, std::span<const Vector2<T>> points, std::span<std::uint8_t> inside)
+    {
+        if (inside.size() < points.size())
+            throw std::runtime_error("Output span too small");
+
+        // Edges are stored as structure of arrays with the inverse slope precomputed, so the per point loop
+        // is free of divisions and branches
+        const std::size_t n = polygon.size();
+        std::vector<double> x0(n), y0(n), y1(n), invSlope(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const Vector2<T> &a = polygon[i];
+            const Vector2<T> &b = polygon[(i + 1) % n];
+            x0[i] = a.x;
+            y0[i] = a.y;
+            y1[i] = b.y;
+            invSlope[i] = a.y == b.y ? 0.0 : (double(b.x) - a.x) / (double(b.y) - a.y);
+        }
+
+        Parallel::forChunks(points.size(), 1 << 10, [&](std::size_t begin, std::size_t end, std::size_t)
+                            {
+            for (std::size_t p = begin; p < end; p++)
+            {
+                const double px = points[p].x;
+                const double py = points[p].y;
+                bool odd = false;
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    const bool crosses = (y0[i] > py) != (y1[i] > py);
+                    const double xCross = x0[i] + (py - y0[i]) * invSlope[i];
+                    odd ^= crosses & (px < xCross);
+                }
+                inside[p] = odd;
+            } });
+    }
+
+    /// @brief Returns whether point lies inside the polygon (even-odd rule)
+    template <typename T>
+    [[nodiscard]] bool contains(std::span<const Vector2<T>> polygon, const Vector2<T> &point)
+    {
+        std::uint8_t inside;
+        contains(polygon, std::span<const Vector2<T>>(&point, 1), std::span<std::uint8_t>(&inside, 1));
+        return inside;
+    }
+
+    /// @brief Returns the convex hull in counter-clockwise order, starting at the lexicographically smallest point
+    /// @details Andrew's monotone chain on top of a parallel sort. Collinear points on the hull are dropped.
+    template <typename T>
+    [[nodiscard]] std::vector<Vector2<T>> convexHull(std::span<const Vector2<T>> points)
+    {
+        const auto lexLess = [](const Vector2<T> &a, const Vector2<T> &b)
+        { return a.x < b.x || (a.x == b.x && a.y < b.y); };
+
+        std::vector<Vector2<T>> sorted(points.begin(), points.end());
+        Parallel::sort(sorted.begin(), sorted.end(), lexLess);
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+        if (sorted.size() < 3)
+            return sorted;
+
+        std::vector<Vector2<T>> hull;
+        hull.reserve(sorted.size() + 1);
+
+        const auto pushHullPoint = [&hull](const Vector2<T> &p, std::size_t minSize)
+        {
+            while (hull.size() >= minSize && orient2d(hull[hull.size() - 2], hull.back(), p) != Orientation::CounterClockwise)
+                hull.pop_back();
+            hull.push_back(p);
+        };
+
+        for (const Vector2<T> &p : sorted)
+            pushHullPoint(p, 2);
+        const std::size_t lowerSize = hull.size() + 1;
+        for (std::size_t i = sorted.size() - 1; i-- > 0;)
+            pushHullPoint(sorted[i], lowerSize);
+
+        hull.pop_back();
+        return hull;
+    }
+}
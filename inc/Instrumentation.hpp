@@ -0,0 +1,261 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#ifdef VECTOR2_INSTRUMENTATION
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+/// @brief Opt-in counters for the expensive primitives behind the Vector2 member functions
+/// @details Counting is only compiled in if VECTOR2_INSTRUMENTATION is defined (CMake option of the same name).
+/// Otherwise VECTOR2_COUNT expands to nothing, Region is empty and all snapshots are zero.
+namespace Instr
+{
+    enum class Counter : std::size_t
+    {
+        Sqrt,
+        Atan2,
+        Sin,
+        Cos,
+        Division,
+        Count
+    };
+
+    /// @brief Returns the name a Counter is exported as
+    constexpr const char *counterName(Counter c)
+    {
+        constexpr const char *names[] = {"sqrt", "atan2", "sin", "cos", "division"};
+        return names[static_cast<std::size_t>(c)];
+    }
+
+    /// @brief Counter values at one point in time
+    struct Snapshot
+    {
+        std::array<std::uint64_t, static_cast<std::size_t>(Counter::Count)> counts{};
+
+        [[nodiscard]] constexpr std::uint64_t operator[](Counter c) const
+        {
+            return counts[static_cast<std::size_t>(c)];
+        }
+
+        constexpr Snapshot &operator+=(const Snapshot &other)
+        {
+            for (std::size_t i = 0; i < counts.size(); i++)
+                counts[i] += other.counts[i];
+            return *this;
+        }
+
+        /// @brief Returns the counts that happened between other and this
+        [[nodiscard]] constexpr Snapshot operator-(const Snapshot &other) const
+        {
+            Snapshot ret;
+            for (std::size_t i = 0; i < counts.size(); i++)
+                ret.counts[i] = counts[i] - other.counts[i];
+            return ret;
+        }
+    };
+
+#ifdef VECTOR2_INSTRUMENTATION
+    namespace detail
+    {
+        /// @brief Counters of one thread. Only the owning thread writes, so plain relaxed loads and stores suffice
+        struct alignas(64) ThreadCounters
+        {
+            std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Counter::Count)> counts{};
+
+            Snapshot load() const
+            {
+                Snapshot ret;
+                for (std::size_t i = 0; i < counts.size(); i++)
+                    ret.counts[i] = counts[i].load(std::memory_order_relaxed);
+                return ret;
+            }
+        };
+
+        /// @brief Counters of all running threads that counted, plus the totals of the threads that exited
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<const ThreadCounters *> threads;
+            Snapshot retired;
+            std::map<std::string, Snapshot> regions;
+        };
+
+        inline Registry &registry()
+        {
+            static Registry r;
+            return r;
+        }
+
+        /// @brief Registers the counters of a thread for its lifetime and folds them into the retired total on exit
+        struct LocalCounters
+        {
+            ThreadCounters counters;
+
+            LocalCounters()
+            {
+                std::lock_guard lock(registry().mutex);
+                registry().threads.push_back(&counters);
+            }
+
+            LocalCounters(const LocalCounters &) = delete;
+            LocalCounters &operator=(const LocalCounters &) = delete;
+
+            ~LocalCounters()
+            {
+                Registry &r = registry();
+                std::lock_guard lock(r.mutex);
+                r.retired += counters.load();
+                *std::find(r.threads.begin(), r.threads.end(), &counters) = r.threads.back();
+                r.threads.pop_back();
+            }
+        };
+
+        inline ThreadCounters &local()
+        {
+            thread_local LocalCounters local;
+            return local.counters;
+        }
+
+        inline void increment(Counter c, std::uint64_t n)
+        {
+            std::atomic<std::uint64_t> &counter = local().counts[static_cast<std::size_t>(c)];
+            counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Returns the counts of the calling thread
+    [[nodiscard]] inline Snapshot threadSnapshot()
+    {
+        return detail::local().load();
+    }
+
+    /// @brief Returns the counts summed over all threads
+    [[nodiscard]] inline Snapshot snapshot()
+    {
+        std::lock_guard lock(detail::registry().mutex);
+        Snapshot ret = detail::registry().retired;
+        for (const detail::ThreadCounters *t : detail::registry().threads)
+            ret += t->load();
+        return ret;
+    }
+
+    /// @brief Returns the counts accumulated by every named Region, summed over all threads
+    [[nodiscard]] inline std::map<std::string, Snapshot> regions()
+    {
+        std::lock_guard lock(detail::registry().mutex);
+        return detail::registry().regions;
+    }
+
+    /// @brief Adds everything the calling thread counts during its lifetime to the region called name
+    class Region
+    {
+    private:
+        std::string _name;
+        Snapshot _start;
+
+    public:
+        explicit Region(std::string name)
+            : _name(std::move(name)), _start(threadSnapshot())
+        {
+        }
+
+        Region(const Region &) = delete;
+        Region &operator=(const Region &) = delete;
+
+        ~Region()
+        {
+            const Snapshot delta = threadSnapshot() - _start;
+            std::lock_guard lock(detail::registry().mutex);
+            detail::registry().regions[_name] += delta;
+        }
+    };
+
+#define VECTOR2_COUNT(counter, n) \
+    (std::is_constant_evaluated() ? void() : ::Instr::detail::increment(::Instr::Counter::counter, n))
+#else
+    [[nodiscard]] inline Snapshot threadSnapshot()
+    {
+        return {};
+    }
+
+    [[nodiscard]] inline Snapshot snapshot()
+    {
+        return {};
+    }
+
+    [[nodiscard]] inline std::map<std::string, Snapshot> regions()
+    {
+        return {};
+    }
+
+    class Region
+    {
+    public:
+        template <typename S>
+        explicit Region(const S &)
+        {
+        }
+    };
+
+#define VECTOR2_COUNT(counter, n) ((void)0)
+#endif
+
+    /// @brief Exports a Snapshot as a JSON object, e.g. {"sqrt":3,"atan2":1,...}
+    [[nodiscard]] inline std::string toJson(const Snapshot &s)
+    {
+        std::string ret = "{";
+        for (std::size_t i = 0; i < s.counts.size(); i++)
+        {
+            if (i != 0)
+                ret += ',';
+            ret += '"';
+            ret += counterName(static_cast<Counter>(i));
+            ret += "\":";
+            ret += std::to_string(s.counts[i]);
+        }
+        return ret + '}';
+    }
+
+    /// @brief Returns s as the body of a JSON string, escaping quotes, backslashes and control characters
+    [[nodiscard]] inline std::string escapeJson(const std::string &s)
+    {
+        constexpr char hex[] = "0123456789abcdef";
+        std::string ret;
+        for (const char c : s)
+        {
+            const unsigned char u = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\')
+                ret += {'\\', c};
+            else if (u < 0x20)
+                ret += {'\\', 'u', '0', '0', hex[u >> 4], hex[u & 15]};
+            else
+                ret += c;
+        }
+        return ret;
+    }
+
+    /// @brief Exports the totals of all threads and all regions as {"total":{...},"regions":{"name":{...},...}}
+    [[nodiscard]] inline std::string reportJson()
+    {
+        std::string ret = "{\"total\":" + toJson(snapshot()) + ",\"regions\":{";
+        bool first = true;
+        for (const auto &[name, counts] : regions())
+        {
+            if (!first)
+                ret += ',';
+            first = false;
+            ret += '"' + escapeJson(name) + "\":" + toJson(counts);
+        }
+        return ret + "}}";
+    }
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "Vector2.hpp"
+#include "Parallel.hpp"
+
+#include "KernelMath.hpp"
+
+#ifdef VECTOR2_DISPATCH
+#include "Dispatch.hpp"
+#endif
+
+/// @brief Particle state stored as structure of arrays, so the integration kernels stream through contiguous memory
+template <typename T>
+struct Particles2
+{
+    std::vector<T> px, py, vx, vy, ax, ay;
+
+    /// @brief Returns the number of particles
+    [[nodiscard]] std::size_t size() const
+    {
+        return px.size();
+    }
+
+    /// @brief Resizes all arrays, new particles are at rest in the origin
+    void resize(std::size_t n)
+    {
+        for (std::vector<T> *v : {&px, &py, &vx, &vy, &ax, &ay})
+            v->resize(n);
+    }
+
+    /// @brief Appends a particle
+    void push(Vector2<T> position, Vector2<T> velocity = Vector2<T>(), Vector2<T> acceleration = Vector2<T>())
+    {
+        px.push_back(position.x);
+        py.push_back(position.y);
+        vx.push_back(velocity.x);
+        vy.push_back(velocity.y);
+        ax.push_back(acceleration.x);
+        ay.push_back(acceleration.y);
+    }
+
+    /// @brief Returns the position of particle i
+    [[nodiscard]] Vector2<T> getPosition(std::size_t i) const
+    {
+        return Vector2<T>(px[i], py[i]);
+    }
+
+    /// @brief Returns the velocity of particle i
+    [[nodiscard]] Vector2<T> getVelocity(std::size_t i) const
+    {
+        return Vector2<T>(vx[i], vy[i]);
+    }
+
+    /// @brief Returns the acceleration of particle i
+    [[nodiscard]] Vector2<T> getAcceleration(std::size_t i) const
+    {
+        return Vector2<T>(ax[i], ay[i]);
+    }
+};
+
+namespace Integrate
+{
+    template <typename T>
+    struct Settings
+    {
+        /// @brief Time step
+        T dt;
+        /// @brief Fraction of the velocity lost per unit of time, 0 disables damping
+        T damping = 0;
+        /// @brief Speeds above this are clamped to it
+        T maxSpeed = std::numeric_limits<T>::infinity();
+        /// @brief Whether large particle counts are split across threads
+        bool parallel = true;
+    };
+
+    namespace detail
+    {
+        /// @brief Particles per chunk below which a step stays on the calling thread
+        constexpr std::size_t minChunk = 1 << 15;
+
+        inline namespace VECTOR2_KERNEL_NAMESPACE
+        {
+            /// @brief Applies damping and, if Clamp is set, the speed limit
+            /// @details Written without branches so the calling loops vectorize. The square root of the clamped
+            /// variant only vectorizes with -fno-math-errno -fno-trapping-math, hence the separate unclamped variant.
+            template <bool Clamp, typename T>
+            VECTOR2_KERNEL_INLINE void limit(T &vx, T &vy, T damp, T maxSpeed)
+            {
+                vx *= damp;
+                vy *= damp;
+                if constexpr (Clamp)
+                {
+                    const T speed2 = vx * vx + vy * vy;
+                    const T scale = speed2 > maxSpeed * maxSpeed ? maxSpeed / KernelMath::sqrt(speed2) : T(1);
+                    vx *= scale;
+                    vy *= scale;
+                }
+            }
+
+            // The kernels take restrict qualified pointers and plain values. Otherwise the compiler has to assume that
+            // the arrays alias each other or the step parameters, which needs more runtime checks than it is willing
+            // to emit and keeps the loops scalar
+
+            template <bool Clamp, typename T>
+            void eulerKernel(T *__restrict px, T *__restrict py, T *__restrict vx, T *__restrict vy, const T *__restrict ax, const T *__restrict ay, std::size_t begin, std::size_t end, T dt, T damp, T maxSpeed)
+            {
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    px[i] += vx[i] * dt;
+                    py[i] += vy[i] * dt;
+                    T x = vx[i] + ax[i] * dt, y = vy[i] + ay[i] * dt;
+                    limit<Clamp>(x, y, damp, maxSpeed);
+                    vx[i] = x;
+                    vy[i] = y;
+                }
+            }
+
+            template <bool Clamp, typename T>
+            void semiImplicitEulerKernel(T *__restrict px, T *__restrict py, T *__restrict vx, T *__restrict vy, const T *__restrict ax, const T *__restrict ay, std::size_t begin, std::size_t end, T dt, T damp, T maxSpeed)
+            {
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    T x = vx[i] + ax[i] * dt, y = vy[i] + ay[i] * dt;
+                    limit<Clamp>(x, y, damp, maxSpeed);
+                    vx[i] = x;
+                    vy[i] = y;
+                    px[i] += x * dt;
+                    py[i] += y * dt;
+                }
+            }
+
+            template <typename T>
+            void verletPositionsKernel(T *__restrict px, T *__restrict py, T *__restrict vx, T *__restrict vy, const T *__restrict ax, const T *__restrict ay, std::size_t begin, std::size_t end, T dt)
+            {
+                const T halfDt = dt / 2;
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    const T x = vx[i] + ax[i] * halfDt, y = vy[i] + ay[i] * halfDt;
+                    vx[i] = x;
+                    vy[i] = y;
+                    px[i] += x * dt;
+                    py[i] += y * dt;
+                }
+            }
+
+            template <bool Clamp, typename T>
+            void verletVelocitiesKernel(T *__restrict vx, T *__restrict vy, const T *__restrict ax, const T *__restrict ay, std::size_t begin, std::size_t end, T dt, T damp, T maxSpeed)
+            {
+                const T halfDt = dt / 2;
+                for (std::size_t i = begin; i < end; i++)
+                {
+                    T x = vx[i] + ax[i] * halfDt, y = vy[i] + ay[i] * halfDt;
+                    limit<Clamp>(x, y, damp, maxSpeed);
+                    vx[i] = x;
+                    vy[i] = y;
+                }
+            }
+        }
+
+        template <typename T, typename F>
+        void forParticles(const Particles2<T> &p, const Settings<T> &settings, F &&fn)
+        {
+            if (settings.parallel)
+                Parallel::forChunks(p.size(), minChunk, fn);
+            else
+                fn(std::size_t(0), p.size(), std::size_t(0));
+        }
+
+        template <typename T>
+        T dampingFactor(const Settings<T> &settings)
+        {
+            return std::max(T(0), T(1) - settings.damping * settings.dt);
+        }
+
+        template <typename T>
+        bool hasSpeedLimit(const Settings<T> &settings)
+        {
+            return settings.maxSpeed < std::numeric_limits<T>::infinity();
+        }
+    }
+
+    /// @brief Explicit Euler step, positions advance with the velocity from the start of the step
+    template <typename T>
+    void euler(Particles2<T> &p, const Settings<T> &settings)
+    {
+        const T dt = settings.dt, damp = detail::dampingFactor(settings), maxSpeed = settings.maxSpeed;
+        auto kernel = detail::hasSpeedLimit(settings) ? detail::eulerKernel<true, T> : detail::eulerKernel<false, T>;
+#ifdef VECTOR2_DISPATCH
+        if constexpr (std::is_same_v<T, float>)
+            kernel = detail::hasSpeedLimit(settings) ? Dispatch::kernels().eulerClamped : Dispatch::kernels().euler;
+#endif
+        detail::forParticles(p, settings, [&](std::size_t begin, std::size_t end, std::size_t)
+                             { kernel(p.px.data(), p.py.data(), p.vx.data(), p.vy.data(), p.ax.data(), p.ay.data(), begin, end, dt, damp, maxSpeed); });
+    }
+
+    /// @brief Semi-implicit (symplectic) Euler step, positions advance with the already updated velocity
+    template <typename T>
+    void semiImplicitEuler(Particles2<T> &p, const Settings<T> &settings)
+    {
+        const T dt = settings.dt, damp = detail::dampingFactor(settings), maxSpeed = settings.maxSpeed;
+        auto kernel = detail::hasSpeedLimit(settings) ? detail::semiImplicitEulerKernel<true, T> : detail::semiImplicitEulerKernel<false, T>;
+#ifdef VECTOR2_DISPATCH
+        if constexpr (std::is_same_v<T, float>)
+            kernel = detail::hasSpeedLimit(settings) ? Dispatch::kernels().semiImplicitEulerClamped : Dispatch::kernels().semiImplicitEuler;
+#endif
+        detail::forParticles(p, settings, [&](std::size_t begin, std::size_t end, std::size_t)
+                             { kernel(p.px.data(), p.py.data(), p.vx.data(), p.vy.data(), p.ax.data(), p.ay.data(), begin, end, dt, damp, maxSpeed); });
+    }
+
+    /// @brief First half of a velocity Verlet step: half kick with the current acceleration, then drift
+    template <typename T>
+    void verletPositions(Particles2<T> &p, const Settings<T> &settings)
+    {
+        const T dt = settings.dt;
+        auto kernel = detail::verletPositionsKernel<T>;
+#ifdef VECTOR2_DISPATCH
+        if constexpr (std::is_same_v<T, float>)
+            kernel = Dispatch::kernels().verletPositions;
+#endif
+        detail::forParticles(p, settings, [&](std::size_t begin, std::size_t end, std::size_t)
+                             { kernel(p.px.data(), p.py.data(), p.vx.data(), p.vy.data(), p.ax.data(), p.ay.data(), begin, end, dt); });
+    }
+
+    /// @brief Second half of a velocity Verlet step: half kick with the acceleration at the new positions
+    template <typename T>
+    void verletVelocities(Particles2<T> &p, const Settings<T> &settings)
+    {
+        const T dt = settings.dt, damp = detail::dampingFactor(settings), maxSpeed = settings.maxSpeed;
+        auto kernel = detail::hasSpeedLimit(settings) ? detail::verletVelocitiesKernel<true, T> : detail::verletVelocitiesKernel<false, T>;
+#ifdef VECTOR2_DISPATCH
+        if constexpr (std::is_same_v<T, float>)
+            kernel = detail::hasSpeedLimit(settings) ? Dispatch::kernels().verletVelocitiesClamped : Dispatch::kernels().verletVelocities;
+#endif
+        detail::forParticles(p, settings, [&](std::size_t begin, std::size_t end, std::size_t)
+                             { kernel(p.vx.data(), p.vy.data(), p.ax.data(), p.ay.data(), begin, end, dt, damp, maxSpeed); });
+    }
+
+    /// @brief Full velocity Verlet step
+    /// @param computeAcceleration Called with the particles after the drift, has to refill ax and ay
+    template <typename T, typename F>
+    void velocityVerlet(Particles2<T> &p, const Settings<T> &settings, F &&computeAcceleration)
+    {
+        verletPositions(p, settings);
+        computeAcceleration(p);
+        verletVelocities(p, settings);
+    }
+}
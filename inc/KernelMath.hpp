@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+// Namespace of the raw kernels, src/Kernels.cpp sets it per ISA level
+#ifndef VECTOR2_KERNEL_NAMESPACE
+#define VECTOR2_KERNEL_NAMESPACE generic
+#endif
+
+#if defined(__GNUC__)
+#define VECTOR2_KERNEL_INLINE [[gnu::always_inline]] inline
+#else
+#define VECTOR2_KERNEL_INLINE inline
+#endif
+
+/// @brief Replacements for std::min, std::max and std::sqrt inside the raw kernels
+/// @details Without optimization the std functions are emitted out of line as weak symbols. In a translation unit
+/// compiled for a higher ISA level the linker may then pick that copy for the whole program, and baseline code ends
+/// up running AVX instructions. These helpers are always inlined and live in the per ISA namespace, so every
+/// symbol of a kernel object is distinct.
+namespace KernelMath
+{
+    inline namespace VECTOR2_KERNEL_NAMESPACE
+    {
+        /// @brief Same as std::min, returns a if b is NaN
+        template <typename T>
+        VECTOR2_KERNEL_INLINE T min(T a, T b)
+        {
+            return b < a ? b : a;
+        }
+
+        /// @brief Same as std::max, returns a if b is NaN
+        template <typename T>
+        VECTOR2_KERNEL_INLINE T max(T a, T b)
+        {
+            return a < b ? b : a;
+        }
+
+        template <typename T>
+        VECTOR2_KERNEL_INLINE T sqrt(T x)
+        {
+#if defined(__GNUC__)
+            if constexpr (std::is_same_v<T, float>)
+                return __builtin_sqrtf(x);
+            else if constexpr (std::is_same_v<T, double>)
+                return __builtin_sqrt(x);
+            else
+                return std::sqrt(x);
+#else
+            return std::sqrt(x);
+#endif
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Parallel
+{
+    /// @brief Number of threads the batch algorithms spread their work over
+    inline std::size_t threadCount()
+    {
+        const unsigned int hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 1 : hw;
+    }
+
+    /// @brief Number of chunks [0, n) is split into if every chunk should hold at least minChunk elements
+    inline std::size_t chunkCount(std::size_t n, std::size_t minChunk)
+    {
+        return std::clamp<std::size_t>(n / std::max<std::size_t>(minChunk, 1), 1, threadCount());
+    }
+
+    /// @brief Calls fn(begin, end, chunk) for each of the chunkCount(n, minChunk) contiguous chunks of [0, n)
+    /// @details Every chunk but the last runs on its own thread, the last one on the calling thread.
+    /// Inputs smaller than 2 * minChunk are processed without spawning any thread.
+    template <typename F>
+    void forChunks(std::size_t n, std::size_t minChunk, F &&fn)
+    {
+        const std::size_t chunks = chunkCount(n, minChunk);
+        if (chunks == 1)
+        {
+            fn(std::size_t(0), n, std::size_t(0));
+            return;
+        }
+
+        std::vector<std::jthread> workers;
+        workers.reserve(chunks - 1);
+        for (std::size_t c = 0; c + 1 < chunks; c++)
+            workers.emplace_back([&fn, c, n, chunks]
+                                 { fn(c * n / chunks, (c + 1) * n / chunks, c); });
+        fn((chunks - 1) * n / chunks, n, chunks - 1);
+    }
+
+    /// @brief Sorts [first, last) by sorting chunks in parallel and merging them pairwise
+    template <typename It, typename Comp>
+    void sort(It first, It last, Comp comp, std::size_t minChunk = 1 << 14)
+    {
+        const std::size_t n = last - first;
+        const std::size_t chunks = chunkCount(n, minChunk);
+
+        forChunks(n, minChunk, [&](std::size_t begin, std::size_t end, std::size_t)
+                  { std::sort(first + begin, first + end, comp); });
+
+        for (std::size_t width = 1; width < chunks; width *= 2)
+        {
+            std::vector<std::jthread> workers;
+            for (std::size_t c = 0; c + width < chunks; c += 2 * width)
+            {
+                const std::size_t begin = c * n / chunks;
+                const std::size_t mid = (c + width) * n / chunks;
+                const std::size_t end = std::min(c + 2 * width, chunks) * n / chunks;
+                workers.emplace_back([=]
+                                     { std::inplace_merge(first + begin, first + mid, first + end, comp); });
+            }
+        }
+    }
+}
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Vector2.hpp"
+#include "Parallel.hpp"
+
+/// @brief Open polyline that keeps the cumulative arc length up to every point
+/// @details Arc lengths are prefix sums that are extended in O(1) by append(), so length queries are O(1)
+/// and sampling by distance is a binary search instead of summing getLength() over all segments.
+template <typename T>
+class Polyline2
+{
+private:
+    std::vector<Vector2<T>> _points;
+    std::vector<double> _arcLength;
+
+    static double distance(const Vector2<T> &a, const Vector2<T> &b)
+    {
+        return std::hypot(double(b.x) - a.x, double(b.y) - a.y);
+    }
+
+    /// @brief Squared distance of p to the segment from a to b
+    static double segmentDistance2(const Vector2<T> &p, const Vector2<T> &a, const Vector2<T> &b)
+    {
+        const double dx = double(b.x) - a.x, dy = double(b.y) - a.y;
+        const double px = double(p.x) - a.x, py = double(p.y) - a.y;
+        const double len2 = dx * dx + dy * dy;
+        const double t = len2 == 0.0 ? 0.0 : std::clamp((px * dx + py * dy) / len2, 0.0, 1.0);
+        const double ex = px - t * dx, ey = py - t * dy;
+        return ex * ex + ey * ey;
+    }
+
+    static double triangleArea(const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c)
+    {
+        return std::abs((double(b.x) - a.x) * (double(c.y) - a.y) - (double(b.y) - a.y) * (double(c.x) - a.x)) / 2;
+    }
+
+    /// @brief Douglas-Peucker on [first, last] with an explicit stack, marking kept points in keep
+    void douglasPeucker(std::size_t first, std::size_t last, double epsilon2, std::vector<std::uint8_t> &keep) const
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> stack{{first, last}};
+        while (!stack.empty())
+        {
+            const auto [a, b] = stack.back();
+            stack.pop_back();
+
+            const std::size_t split = farthestPoint(a, b, epsilon2);
+            if (split == b)
+                continue;
+            keep[split] = 1;
+            stack.emplace_back(a, split);
+            stack.emplace_back(split, b);
+        }
+    }
+
+    /// @brief Returns the point of (a, b) farthest from the segment a-b if it is farther than the tolerance, b otherwise
+    std::size_t farthestPoint(std::size_t a, std::size_t b, double epsilon2) const
+    {
+        double maxDistance2 = epsilon2;
+        std::size_t split = b;
+        for (std::size_t i = a + 1; i < b; i++)
+        {
+            const double d2 = segmentDistance2(_points[i], _points[a], _points[b]);
+            if (d2 > maxDistance2)
+            {
+                maxDistance2 = d2;
+                split = i;
+            }
+        }
+        return split;
+    }
+
+    /// @brief Visvalingam-Whyatt on [first, last], the end points are always kept
+    void visvalingam(std::size_t first, std::size_t last, double minArea, std::vector<std::uint8_t> &keep) const
+    {
+        if (last - first < 2)
+            return;
+
+        // Doubly linked list over the points and a min-heap of triangle areas. Entries whose area is outdated
+        // because a neighbour was removed are recognized by their version and skipped.
+        std::vector<std::size_t> prev(last - first + 1), next(last - first + 1);
+        std::vector<std::uint32_t> version(last - first + 1, 0);
+        using Entry = std::tuple<double, std::size_t, std::uint32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+        for (std::size_t i = first; i <= last; i++)
+        {
+            prev[i - first] = i - 1;
+            next[i - first] = i + 1;
+            if (i != first && i != last)
+                heap.emplace(triangleArea(_points[i - 1], _points[i], _points[i + 1]), i, 0);
+        }
+
+        while (!heap.empty())
+        {
+            const auto [area, i, v] = heap.top();
+            heap.pop();
+            if (v != version[i - first])
+                continue;
+            if (area >= minArea)
+                break;
+
+            keep[i] = 0;
+            const std::size_t p = prev[i - first], n = next[i - first];
+            next[p - first] = n;
+            prev[n - first] = p;
+
+            // Recompute both neighbours, an area never drops below the one just removed
+            if (p != first)
+                heap.emplace(std::max(area, triangleArea(_points[prev[p - first]], _points[p], _points[n])), p, ++version[p - first]);
+            if (n != last)
+                heap.emplace(std::max(area, triangleArea(_points[p], _points[n], _points[next[n - first]])), n, ++version[n - first]);
+        }
+    }
+
+    Vector2<T> interpolate(std::size_t segment, double distance) const
+    {
+        const double segmentLength = _arcLength[segment + 1] - _arcLength[segment];
+        const double t = segmentLength == 0.0 ? 0.0 : std::clamp((distance - _arcLength[segment]) / segmentLength, 0.0, 1.0);
+        const Vector2<T> &a = _points[segment], &b = _points[segment + 1];
+        return Vector2<T>(static_cast<T>(a.x + (double(b.x) - a.x) * t), static_cast<T>(a.y + (double(b.y) - a.y) * t));
+    }
+
+    Polyline2 filtered(const std::vector<std::uint8_t> &keep) const
+    {
+        Polyline2 ret;
+        for (std::size_t i = 0; i < _points.size(); i++)
+            if (keep[i])
+                ret.append(_points[i]);
+        return ret;
+    }
+
+public:
+    /// @brief Default constructor
+    Polyline2()
+    {
+    }
+
+    /// @brief Constructs the polyline through points
+    explicit Polyline2(std::span<const Vector2<T>> points)
+    {
+        reserve(points.size());
+        for (const Vector2<T> &p : points)
+            append(p);
+    }
+
+    /// @brief Reserves memory for n points
+    void reserve(std::size_t n)
+    {
+        _points.reserve(n);
+        _arcLength.reserve(n);
+    }
+
+    /// @brief Appends a point, extending the arc lengths in O(1)
+    void append(const Vector2<T> &p)
+    {
+        _arcLength.push_back(_points.empty() ? 0.0 : _arcLength.back() + distance(_points.back(), p));
+        _points.push_back(p);
+    }
+
+    /// @brief Returns the number of points
+    [[nodiscard]] std::size_t size() const
+    {
+        return _points.size();
+    }
+
+    /// @brief Returns all points
+    [[nodiscard]] std::span<const Vector2<T>> getPoints() const
+    {
+        return _points;
+    }
+
+    /// @brief Returns the arc length from the first point to point i
+    [[nodiscard]] double getArcLength(std::size_t i) const
+    {
+        return _arcLength[i];
+    }
+
+    /// @brief Returns the total length of the Polyline2
+    [[nodiscard]] double getLength() const
+    {
+        return _arcLength.empty() ? 0.0 : _arcLength.back();
+    }
+
+    /// @brief Returns the point at the given arc length in O(log n), distances outside [0, getLength()] are clamped
+    [[nodiscard]] Vector2<T> sampleAt(double distance) const
+    {
+        if (_points.empty())
+            throw std::runtime_error("Sampling an empty Polyline2");
+        if (_points.size() == 1)
+            return _points.front();
+
+        const std::size_t i = std::upper_bound(_arcLength.begin() + 1, _arcLength.end() - 1, distance) - _arcLength.begin();
+        return interpolate(i - 1, distance);
+    }
+
+    /// @brief Returns points spaced evenly by arc length, starting at the first and ending at the last point
+    /// @details Every sample only needs the segment its chunk starts in, so long outputs are produced in parallel.
+    [[nodiscard]] std::vector<Vector2<T>> resample(double spacing) const
+    {
+        if (_points.size() < 2 || !(spacing > 0.0))
+            return _points;
+
+        const std::size_t count = std::size_t(std::ceil(getLength() / spacing)) + 1;
+        std::vector<Vector2<T>> ret(count);
+
+        Parallel::forChunks(count, 1 << 14, [&](std::size_t begin, std::size_t end, std::size_t)
+                            {
+            std::size_t segment = std::upper_bound(_arcLength.begin() + 1, _arcLength.end() - 1, begin * spacing) - _arcLength.begin() - 1;
+            for (std::size_t k = begin; k < end; k++)
+            {
+                const double d = std::min(k * spacing, getLength());
+                while (segment + 2 < _arcLength.size() && _arcLength[segment + 1] <= d)
+                    segment++;
+                ret[k] = interpolate(segment, d);
+            } });
+
+        return ret;
+    }
+
+    /// @brief Douglas-Peucker simplification, keeping every point farther than epsilon from the simplified line
+    /// @details The first subdivisions run on the calling thread until there are enough independent ranges,
+    /// which are then simplified in parallel. The result does not depend on the number of threads.
+    [[nodiscard]] Polyline2 simplifyDouglasPeucker(double epsilon) const
+    {
+        const std::size_t n = _points.size();
+        if (n < 3)
+            return *this;
+
+        const double epsilon2 = epsilon * epsilon;
+        std::vector<std::uint8_t> keep(n, 0);
+        keep.front() = keep.back() = 1;
+
+        constexpr std::size_t minRange = 1 << 14;
+        std::vector<std::pair<std::size_t, std::size_t>> ranges{{0, n - 1}}, pending;
+        while (!ranges.empty() && pending.size() + ranges.size() < 4 * Parallel::threadCount())
+        {
+            std::vector<std::pair<std::size_t, std::size_t>> nextRanges;
+            for (const auto &[a, b] : ranges)
+            {
+                if (b - a < minRange)
+                {
+                    pending.emplace_back(a, b);
+                    continue;
+                }
+                const std::size_t split = farthestPoint(a, b, epsilon2);
+                if (split == b)
+                    continue;
+                keep[split] = 1;
+                nextRanges.emplace_back(a, split);
+                nextRanges.emplace_back(split, b);
+            }
+            ranges = std::move(nextRanges);
+        }
+        pending.insert(pending.end(), ranges.begin(), ranges.end());
+
+        Parallel::forChunks(pending.size(), 1, [&](std::size_t begin, std::size_t end, std::size_t)
+                            {
+            for (std::size_t r = begin; r < end; r++)
+                douglasPeucker(pending[r].first, pending[r].second, epsilon2, keep); });
+
+        return filtered(keep);
+    }
+
+    /// @brief Visvalingam-Whyatt simplification, removing points whose effective triangle area is below minArea
+    /// @details Long polylines are split into chunks of a fixed length that are simplified in parallel, the points
+    /// at the chunk boundaries are always kept. The result does not depend on the number of threads.
+    [[nodiscard]] Polyline2 simplifyVisvalingam(double minArea) const
+    {
+        const std::size_t n = _points.size();
+        if (n < 3)
+            return *this;
+
+        constexpr std::size_t chunkLength = 1 << 16;
+        const std::size_t chunks = (n - 2) / chunkLength + 1;
+        std::vector<std::uint8_t> keep(n, 1);
+        Parallel::forChunks(chunks, 1, [&](std::size_t begin, std::size_t end, std::size_t)
+                            {
+            for (std::size_t c = begin; c < end; c++)
+                visvalingam(c * chunkLength, std::min((c + 1) * chunkLength, n - 1), minArea, keep); });
+
+        return filtered(keep);
+    }
+};
+
+// Common Typedefs
+typedef Polyline2<float> Polyline2f;
+typedef Polyline2<double> Polyline2d;
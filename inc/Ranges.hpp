@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Vector2.hpp"
+#include "Parallel.hpp"
+
+/// @brief Lazy, composable range adaptors over ranges of Vector2
+/// @details pts | Views::rotated(a) | Views::translated(o) | Views::scaled(k) yields a single view whose
+/// element function is one affine transform. Sine and cosine are evaluated once when the adaptor is created
+/// and consecutive affine stages are multiplied together, so every element is touched exactly once.
+namespace Views
+{
+    namespace detail
+    {
+        template <typename V>
+        struct VectorValue
+        {
+        };
+
+        template <typename T>
+        struct VectorValue<Vector2<T>>
+        {
+            using type = T;
+        };
+
+        /// @brief Component type of the Vector2 elements of range R
+        template <typename R>
+        using ComponentOf = typename VectorValue<std::ranges::range_value_t<R>>::type;
+
+        /// @brief Type the transforms are computed in, integer vectors are transformed in double precision
+        template <typename T>
+        using Scalar = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+    }
+
+    /// @brief p -> M * p + t
+    template <typename S>
+    struct Affine
+    {
+        S m00 = 1, m01 = 0, m10 = 0, m11 = 1, tx = 0, ty = 0;
+
+        template <typename T>
+        constexpr Vector2<T> operator()(const Vector2<T> &v) const
+        {
+            return Vector2<T>(static_cast<T>(m00 * v.x + m01 * v.y + tx), static_cast<T>(m10 * v.x + m11 * v.y + ty));
+        }
+    };
+
+    /// @brief Scales every vector to length 1, like Vector2::getNormalized()
+    struct Normalize
+    {
+        template <typename T>
+        Vector2<T> operator()(const Vector2<T> &v) const
+        {
+            const T len = std::sqrt(v.x * v.x + v.y * v.y);
+            return Vector2<T>(v.x / len, v.y / len);
+        }
+    };
+
+    /// @brief Applies First, then Second
+    template <typename First, typename Second>
+    struct Compose
+    {
+        First first;
+        Second second;
+
+        template <typename T>
+        constexpr Vector2<T> operator()(const Vector2<T> &v) const
+        {
+            return second(first(v));
+        }
+    };
+
+    /// @brief Chains two element functions
+    template <typename First, typename Second>
+    constexpr Compose<First, Second> compose(const First &first, const Second &second)
+    {
+        return {first, second};
+    }
+
+    /// @brief Consecutive affine transforms collapse into one
+    template <typename S>
+    constexpr Affine<S> compose(const Affine<S> &a, const Affine<S> &b)
+    {
+        return {b.m00 * a.m00 + b.m01 * a.m10, b.m00 * a.m01 + b.m01 * a.m11,
+                b.m10 * a.m00 + b.m11 * a.m10, b.m10 * a.m01 + b.m11 * a.m11,
+                b.m00 * a.tx + b.m01 * a.ty + b.tx, b.m10 * a.tx + b.m11 * a.ty + b.ty};
+    }
+
+    /// @brief An affine transform following a non-linear one is merged into the trailing affine transform
+    template <typename First, typename S>
+    constexpr Compose<First, Affine<S>> compose(const Compose<First, Affine<S>> &a, const Affine<S> &b)
+    {
+        return {a.first, compose(a.second, b)};
+    }
+
+    /// @brief Pipeline stage for an affine transform, not yet bound to a component type
+    struct AffineStage
+    {
+        double m00 = 1, m01 = 0, m10 = 0, m11 = 1, tx = 0, ty = 0;
+
+        template <typename T>
+        constexpr Affine<detail::Scalar<T>> bind() const
+        {
+            using S = detail::Scalar<T>;
+            return {S(m00), S(m01), S(m10), S(m11), S(tx), S(ty)};
+        }
+    };
+
+    /// @brief Pipeline stage normalizing every vector
+    struct NormalizeStage
+    {
+        template <typename T>
+        constexpr Normalize bind() const
+        {
+            return {};
+        }
+    };
+
+    /// @brief Stages can be chained before they are applied to a range
+    constexpr AffineStage operator|(const AffineStage &a, const AffineStage &b)
+    {
+        const Affine<double> c = compose(a.bind<double>(), b.bind<double>());
+        return {c.m00, c.m01, c.m10, c.m11, c.tx, c.ty};
+    }
+
+    /// @brief Rotates every vector by ang, like Vector2::getRotated()
+    inline AffineStage rotated(Angle ang)
+    {
+        const float cosine = std::cos(ang.getRadians());
+        const float sine = std::sin(ang.getRadians());
+        return {cosine, -sine, sine, cosine, 0, 0};
+    }
+
+    /// @brief Scales every vector by factor, like Vector2::getScaled()
+    constexpr AffineStage scaled(double factor)
+    {
+        return {factor, 0, 0, factor, 0, 0};
+    }
+
+    /// @brief Translates every vector by offset, like Vector2::getTranslated()
+    template <typename T>
+    constexpr AffineStage translated(const Vector2<T> &offset)
+    {
+        return {1, 0, 0, 1, double(offset.x), double(offset.y)};
+    }
+
+    /// @brief Interpolates every vector towards other, like Interp::linear(v, other, t)
+    template <typename T>
+    constexpr AffineStage lerped(const Vector2<T> &other, double t)
+    {
+        t = std::clamp(t, 0.0, 1.0);
+        return {1 - t, 0, 0, 1 - t, other.x * t, other.y * t};
+    }
+
+    /// @brief Normalizes every vector, like Vector2::getNormalized()
+    inline constexpr NormalizeStage normalized{};
+
+    /// @brief Lazy view applying the element function Op to every Vector2 of V
+    template <std::ranges::view V, typename Op>
+    class PipelineView : public std::ranges::view_interface<PipelineView<V, Op>>
+    {
+    private:
+        std::ranges::transform_view<V, Op> _view;
+        Op _op;
+
+    public:
+        PipelineView() = default;
+
+        constexpr PipelineView(V base, Op op)
+            : _view(std::move(base), op), _op(op)
+        {
+        }
+
+        constexpr auto begin() { return _view.begin(); }
+        constexpr auto end() { return _view.end(); }
+        constexpr auto begin() const requires std::ranges::range<const V> { return _view.begin(); }
+        constexpr auto end() const requires std::ranges::range<const V> { return _view.end(); }
+        constexpr auto size() const requires std::ranges::sized_range<const V> { return _view.size(); }
+
+        /// @brief Returns the untransformed range
+        constexpr V base() const & requires std::copy_constructible<V> { return _view.base(); }
+        constexpr V base() && { return std::move(_view).base(); }
+
+        /// @brief Returns the fused element function
+        constexpr const Op &op() const { return _op; }
+    };
+
+    namespace detail
+    {
+        template <typename R>
+        struct IsPipeline : std::false_type
+        {
+        };
+
+        template <typename V, typename Op>
+        struct IsPipeline<PipelineView<V, Op>> : std::true_type
+        {
+        };
+
+        template <typename S>
+        concept Stage = std::is_same_v<S, AffineStage> || std::is_same_v<S, NormalizeStage>;
+
+        template <typename R>
+        concept Vector2Range = std::ranges::viewable_range<R> && requires { typename ComponentOf<R>; };
+    }
+
+    /// @brief Applies a stage to a range of Vector2
+    template <detail::Vector2Range R, detail::Stage S>
+        requires(!detail::IsPipeline<std::remove_cvref_t<R>>::value)
+    constexpr auto operator|(R &&r, const S &stage)
+    {
+        using Op = decltype(stage.template bind<detail::ComponentOf<R>>());
+        return PipelineView<std::views::all_t<R>, Op>(std::views::all(std::forward<R>(r)), stage.template bind<detail::ComponentOf<R>>());
+    }
+
+    namespace detail
+    {
+        template <typename V, typename Op, Stage S>
+        constexpr auto append(V base, const Op &first, const S &stage)
+        {
+            const auto op = compose(first, stage.template bind<ComponentOf<V>>());
+            return PipelineView<V, std::remove_const_t<decltype(op)>>(std::move(base), op);
+        }
+    }
+
+    /// @brief Appends a stage to a pipeline, fusing it into the existing element function
+    template <typename V, typename Op, detail::Stage S>
+        requires std::copy_constructible<V>
+    constexpr auto operator|(const PipelineView<V, Op> &view, const S &stage)
+    {
+        return detail::append(view.base(), view.op(), stage);
+    }
+
+    /// @brief Appends a stage to a temporary pipeline, moving its range along, e.g. an owned container
+    template <typename V, typename Op, detail::Stage S>
+    constexpr auto operator|(PipelineView<V, Op> &&view, const S &stage)
+    {
+        const Op op = view.op();
+        return detail::append(std::move(view).base(), op, stage);
+    }
+
+    namespace detail
+    {
+        template <typename T, typename Op>
+        void applyKernel(const Vector2<T> *__restrict in, Vector2<T> *__restrict out, std::size_t begin, std::size_t end, Op op)
+        {
+            for (std::size_t i = begin; i < end; i++)
+                out[i] = op(in[i]);
+        }
+    }
+
+    /// @brief Evaluates a pipeline into out, which has to be at least as large as the pipeline
+    /// @details Pipelines over contiguous ranges run as a tight loop over raw pointers, split across threads
+    /// for large inputs. out must not overlap the source range.
+    template <typename V, typename Op, typename T>
+    void materialize(const PipelineView<V, Op> &view, std::span<Vector2<T>> out)
+    {
+        if constexpr (std::ranges::contiguous_range<const V> && std::ranges::sized_range<const V>)
+        {
+            // Reads the source through the view instead of copying its range, which may own a container
+            const std::size_t n = std::ranges::size(view);
+            if (out.size() < n)
+                throw std::runtime_error("Output span too small");
+
+            const Vector2<T> *in = std::to_address(view.begin().base());
+            const Op op = view.op();
+            Parallel::forChunks(n, 1 << 14, [in, &out, &op](std::size_t begin, std::size_t end, std::size_t)
+                                { detail::applyKernel(in, out.data(), begin, end, op); });
+        }
+        else
+        {
+            if (out.size() < std::size_t(std::ranges::distance(view)))
+                throw std::runtime_error("Output span too small");
+            std::ranges::copy(view, out.begin());
+        }
+    }
+
+    /// @brief Evaluates a pipeline into a new std::vector
+    template <typename V, typename Op>
+    [[nodiscard]] auto toVector(const PipelineView<V, Op> &view)
+    {
+        using T = detail::ComponentOf<V>;
+        std::vector<Vector2<T>> ret(std::ranges::distance(view));
+        materialize(view, std::span<Vector2<T>>(ret));
+        return ret;
+    }
+}
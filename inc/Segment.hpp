@@ -0,0 +1,115 @@
+#pragma once
+
+#include <optional>
+#include <type_traits>
+
+#include "Vector2.hpp"
+#include "Geometry.hpp"
+
+/// @brief Coordinate type of computed intersection points, integer segments intersect in double precision
+template <typename T>
+using IntersectionPoint = Vector2<std::conditional_t<std::is_floating_point_v<T>, T, double>>;
+
+template <typename T>
+struct Segment2
+{
+    Vector2<T> a, b;
+
+    /// @brief Default constructor
+    constexpr Segment2()
+        : a(), b()
+    {
+    }
+
+    /// @brief Parameterized constructor
+    /// @param a_ Start point
+    /// @param b_ End point
+    constexpr Segment2(Vector2<T> a_, Vector2<T> b_)
+        : a(a_), b(b_)
+    {
+    }
+
+    /// @brief Returns the vector from a to b
+    [[nodiscard]] constexpr Vector2<T> getDirection() const
+    {
+        return Vector2<T>(b.x - a.x, b.y - a.y);
+    }
+
+    /// @brief Returns the length of the Segment2
+    [[nodiscard]] constexpr T getLength() const
+    {
+        return getDirection().getLength();
+    }
+};
+
+/// @brief Equality operator
+template <typename Ta, typename Tb>
+constexpr bool operator==(const Segment2<Ta> &s, const Segment2<Tb> &t)
+{
+    return s.a == t.a && s.b == t.b;
+}
+
+namespace Geometry::detail
+{
+    /// @brief Whether p, known to be collinear with s, lies within the bounding box of s
+    template <typename T>
+    constexpr bool withinBounds(const Segment2<T> &s, const Vector2<T> &p)
+    {
+        return std::min(s.a.x, s.b.x) <= p.x && p.x <= std::max(s.a.x, s.b.x) &&
+               std::min(s.a.y, s.b.y) <= p.y && p.y <= std::max(s.a.y, s.b.y);
+    }
+
+    /// @brief Lexicographic (x, then y) less-than
+    template <typename T>
+    constexpr bool lexLess(const Vector2<T> &a, const Vector2<T> &b)
+    {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+}
+
+/// @brief Returns whether two segments share at least one point, exact for all inputs
+template <typename T>
+[[nodiscard]] bool intersects(const Segment2<T> &s, const Segment2<T> &t)
+{
+    using Geometry::Orientation;
+
+    const Orientation o1 = Geometry::orient2d(s.a, s.b, t.a);
+    const Orientation o2 = Geometry::orient2d(s.a, s.b, t.b);
+    const Orientation o3 = Geometry::orient2d(t.a, t.b, s.a);
+    const Orientation o4 = Geometry::orient2d(t.a, t.b, s.b);
+
+    if (o1 != Orientation::Collinear && o2 != Orientation::Collinear && o1 != o2 &&
+        o3 != Orientation::Collinear && o4 != Orientation::Collinear && o3 != o4)
+        return true;
+
+    return (o1 == Orientation::Collinear && Geometry::detail::withinBounds(s, t.a)) ||
+           (o2 == Orientation::Collinear && Geometry::detail::withinBounds(s, t.b)) ||
+           (o3 == Orientation::Collinear && Geometry::detail::withinBounds(t, s.a)) ||
+           (o4 == Orientation::Collinear && Geometry::detail::withinBounds(t, s.b));
+}
+
+/// @brief Returns the intersection point of two segments, if there is one
+/// @details Collinear overlapping segments return the lexicographically smallest point of their overlap.
+template <typename T>
+[[nodiscard]] std::optional<IntersectionPoint<T>> intersect(const Segment2<T> &s, const Segment2<T> &t)
+{
+    using P = IntersectionPoint<T>;
+
+    if (!intersects(s, t))
+        return std::nullopt;
+
+    const double rx = double(s.b.x) - s.a.x, ry = double(s.b.y) - s.a.y;
+    const double qx = double(t.b.x) - t.a.x, qy = double(t.b.y) - t.a.y;
+    const double denom = rx * qy - ry * qx;
+
+    if (denom == 0.0)
+    {
+        const Vector2<T> &sMin = Geometry::detail::lexLess(s.a, s.b) ? s.a : s.b;
+        const Vector2<T> &tMin = Geometry::detail::lexLess(t.a, t.b) ? t.a : t.b;
+        return static_cast<P>(Geometry::detail::lexLess(sMin, tMin) ? tMin : sMin);
+    }
+
+    const double wx = double(t.a.x) - s.a.x, wy = double(t.a.y) - s.a.y;
+    const double u = std::clamp((wx * qy - wy * qx) / denom, 0.0, 1.0);
+    return P(s.a.x + rx * u, s.a.y + ry * u);
+}
@@ -0,0 +1,499 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Segment.hpp"
+#include "Parallel.hpp"
+
+namespace Segments
+{
+    /// @brief Intersections stored as two parallel contiguous buffers
+    template <typename T>
+    struct IntersectionList
+    {
+        /// @brief points[i] is where the segments of pairs[i] intersect
+        std::vector<IntersectionPoint<T>> points;
+        /// @brief Indices of the intersecting segments, always first < second for self intersection queries
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+
+        [[nodiscard]] std::size_t size() const
+        {
+            return pairs.size();
+        }
+
+        void clear()
+        {
+            points.clear();
+            pairs.clear();
+        }
+
+        void append(const IntersectionList &other)
+        {
+            points.insert(points.end(), other.points.begin(), other.points.end());
+            pairs.insert(pairs.end(), other.pairs.begin(), other.pairs.end());
+        }
+    };
+
+    /// @brief Intersects segment with every segment of others, appending hits as (index, offset + j) to out
+    /// @details A branch free first pass over all of others computes the parametric test in double precision,
+    /// widened by a bound on its rounding error, so it never drops a real intersection. Only the candidates it
+    /// flags are confirmed by the exact intersect().
+    template <typename T>
+    void oneToMany(const Segment2<T> &segment, std::span<const Segment2<T>> others, IntersectionList<T> &out,
+                   std::size_t index = 0, std::size_t offset = 0)
+    {
+        // Covers the rounding of the differences, the products and the subtraction with plenty of margin
+        constexpr double errorFactor = 8 * std::numeric_limits<double>::epsilon();
+
+        const double ax = segment.a.x, ay = segment.a.y;
+        const double rx = double(segment.b.x) - ax, ry = double(segment.b.y) - ay;
+
+        std::vector<std::uint8_t> candidate(others.size());
+        for (std::size_t j = 0; j < others.size(); j++)
+        {
+            const double qx = double(others[j].b.x) - others[j].a.x;
+            const double qy = double(others[j].b.y) - others[j].a.y;
+            const double wx = others[j].a.x - ax;
+            const double wy = others[j].a.y - ay;
+
+            const double denom = rx * qy - ry * qx;
+            const double sign = denom < 0.0 ? -1.0 : 1.0;
+            const double absDenom = denom * sign;
+            const double u = (wx * qy - wy * qx) * sign;
+            const double v = (wx * ry - wy * rx) * sign;
+
+            // The errors scale with the magnitude of the products, not with their difference
+            const double denomError = errorFactor * (std::abs(rx * qy) + std::abs(ry * qx));
+            const double uError = errorFactor * (std::abs(wx * qy) + std::abs(wy * qx));
+            const double vError = errorFactor * (std::abs(wx * ry) + std::abs(wy * rx));
+
+            // Nearly parallel and degenerate segments, whose denominator is within its error of 0, are always
+            // left to the exact test
+            candidate[j] = (absDenom <= denomError) |
+                           ((u >= -uError) & (u <= absDenom + uError + denomError) &
+                            (v >= -vError) & (v <= absDenom + vError + denomError));
+        }
+
+        for (std::size_t j = 0; j < others.size(); j++)
+        {
+            if (!candidate[j])
+                continue;
+            if (const auto p = intersect(segment, others[j]))
+            {
+                out.points.push_back(*p);
+                out.pairs.emplace_back(index, offset + j);
+            }
+        }
+    }
+
+    /// @brief Returns all intersecting pairs by testing every segment against all following ones
+    /// @details O(n^2), but batched and spread over all threads. Preferable to sweep() for small inputs
+    /// or when most segments intersect.
+    template <typename T>
+    [[nodiscard]] IntersectionList<T> allPairs(std::span<const Segment2<T>> segments)
+    {
+        const std::size_t n = segments.size();
+        std::vector<IntersectionList<T>> partial(Parallel::chunkCount(n, 256));
+
+        // Rows get shorter towards the end, interleaving them keeps the chunks balanced
+        Parallel::forChunks(n, 256, [&](std::size_t, std::size_t, std::size_t chunk)
+                            {
+            for (std::size_t i = chunk; i < n; i += partial.size())
+                oneToMany(segments[i], segments.subspan(i + 1), partial[chunk], i, i + 1); });
+
+        IntersectionList<T> ret;
+        for (const IntersectionList<T> &p : partial)
+            ret.append(p);
+        return ret;
+    }
+
+    namespace detail
+    {
+        /// @brief Floating point expansion of arbitrary length, for the exact predicates on intersection points
+        /// whose products outgrow the fixed size Geometry::detail::Expansion
+        struct ExactValue
+        {
+            /// @brief Nonoverlapping components ordered by increasing magnitude, zeros are eliminated
+            std::vector<double> e;
+
+            ExactValue()
+            {
+            }
+
+            explicit ExactValue(double v)
+            {
+                if (v != 0.0)
+                    e.push_back(v);
+            }
+
+            /// @brief Exact a - b
+            static ExactValue difference(double a, double b)
+            {
+                double x, y;
+                Geometry::detail::twoSum(a, -b, x, y);
+                ExactValue ret(y);
+                ret.add(x);
+                return ret;
+            }
+
+            /// @brief Adds b exactly (Shewchuk's Grow-Expansion with zero elimination)
+            void add(double b)
+            {
+                double q = b;
+                std::size_t k = 0;
+                for (std::size_t i = 0; i < e.size(); i++)
+                {
+                    double h;
+                    Geometry::detail::twoSum(q, e[i], q, h);
+                    if (h != 0.0)
+                        e[k++] = h;
+                }
+                e.resize(k);
+                if (q != 0.0)
+                    e.push_back(q);
+            }
+
+            ExactValue &operator+=(const ExactValue &other)
+            {
+                for (double d : other.e)
+                    add(d);
+                return *this;
+            }
+
+            ExactValue &operator-=(const ExactValue &other)
+            {
+                for (double d : other.e)
+                    add(-d);
+                return *this;
+            }
+
+            friend ExactValue operator*(const ExactValue &a, const ExactValue &b)
+            {
+                ExactValue ret;
+                for (double x : a.e)
+                    for (double y : b.e)
+                    {
+                        double hi, lo;
+                        Geometry::detail::twoProduct(x, y, hi, lo);
+                        ret.add(lo);
+                        ret.add(hi);
+                    }
+                return ret;
+            }
+
+            /// @brief Sign of the exact value, given by the largest component
+            int sign() const
+            {
+                return e.empty() ? 0 : (e.back() > 0.0 ? 1 : -1);
+            }
+
+            /// @brief Value rounded to double, accurate to a few ulps
+            double estimate() const
+            {
+                double sum = 0.0;
+                for (double d : e)
+                    sum += d;
+                return sum;
+            }
+        };
+
+        /// @brief Bentley-Ottmann sweep from left to right, using the event handling of de Berg et al.
+        /// so that endpoints, vertical segments and many segments through one point are supported.
+        /// @details Every decision is exact. Intersection points are kept as rounded values with an error bound and
+        /// the two segments defining them, comparisons the rounded values cannot decide are repeated with
+        /// floating point expansions. Only the reported points are rounded.
+        template <typename T>
+        class Sweep
+        {
+        private:
+            static constexpr double epsilon = std::numeric_limits<double>::epsilon();
+            static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+            struct Seg
+            {
+                double ax, ay, bx, by;
+            };
+
+            /// @brief Event point, either an endpoint (exact, error 0) or the intersection of segments s and t
+            struct Event
+            {
+                double x, y;
+                double error = 0.0; ///< Bound of |x - exact x| and |y - exact y|
+                std::size_t s = none, t = none;
+            };
+
+            /// @brief Exact point (x / d, y / d) with d > 0
+            struct Rational
+            {
+                ExactValue x, y, d;
+            };
+
+            struct EventLess
+            {
+                const Sweep *sweep;
+
+                bool operator()(const Event &a, const Event &b) const
+                {
+                    const int x = sweep->compare(a, b, false);
+                    return x != 0 ? x < 0 : sweep->compare(a, b, true) < 0;
+                }
+            };
+
+            /// @brief Probe for the segments passing through the current event
+            struct AtEvent
+            {
+            };
+
+            /// @brief Orders the status structure from bottom to top at the current event. Segments through the
+            /// event are ordered by their direction, i.e. as right after it, collinear ones by index.
+            struct Compare
+            {
+                using is_transparent = void;
+                const Sweep *sweep;
+
+                bool operator()(std::size_t i, std::size_t j) const
+                {
+                    // Only keys through the event are ever inserted, so at least one side is through it
+                    const int pi = sweep->position(i), pj = sweep->position(j);
+                    if (pi != pj)
+                        return pi < pj;
+                    if (pi == 0)
+                        if (const int turn = sweep->turn(i, j); turn != 0)
+                            return turn > 0;
+                    return i < j;
+                }
+                bool operator()(std::size_t i, AtEvent) const
+                {
+                    return sweep->position(i) < 0;
+                }
+                bool operator()(AtEvent, std::size_t i) const
+                {
+                    return sweep->position(i) > 0;
+                }
+            };
+
+            std::vector<Seg> _segs;
+            Event _event;
+            mutable std::optional<Rational> _exactEvent;
+
+            std::map<Event, std::vector<std::size_t>, EventLess> _events;
+            std::set<std::size_t, Compare> _status;
+            std::unordered_set<std::uint64_t> _reported;
+            IntersectionList<T> _result;
+
+            Segment2<double> segment(std::size_t i) const
+            {
+                const Seg &s = _segs[i];
+                return Segment2<double>(Vector2<double>(s.ax, s.ay), Vector2<double>(s.bx, s.by));
+            }
+
+            /// @brief Exact intersection point of two non parallel segments
+            Rational intersection(std::size_t i, std::size_t j) const
+            {
+                const Seg &s = _segs[i], &t = _segs[j];
+                const ExactValue rx = ExactValue::difference(s.bx, s.ax), ry = ExactValue::difference(s.by, s.ay);
+                const ExactValue qx = ExactValue::difference(t.bx, t.ax), qy = ExactValue::difference(t.by, t.ay);
+                const ExactValue wx = ExactValue::difference(t.ax, s.ax), wy = ExactValue::difference(t.ay, s.ay);
+
+                // p = s.a + r * u / d
+                ExactValue d = rx * qy, u = wx * qy;
+                d -= ry * qx;
+                u -= wy * qx;
+                if (d.sign() < 0)
+                {
+                    d = ExactValue() -= d;
+                    u = ExactValue() -= u;
+                }
+
+                Rational p{ExactValue(s.ax) * d, ExactValue(s.ay) * d, d};
+                p.x += rx * u;
+                p.y += ry * u;
+                return p;
+            }
+
+            /// @brief Exact value of a coordinate of an event as fraction num / den with den > 0
+            void exactCoordinate(const Event &e, bool y, ExactValue &num, ExactValue &den) const
+            {
+                if (e.s == none)
+                {
+                    num = ExactValue(y ? e.y : e.x);
+                    den = ExactValue(1.0);
+                    return;
+                }
+                Rational p = intersection(e.s, e.t);
+                num = std::move(y ? p.y : p.x);
+                den = std::move(p.d);
+            }
+
+            /// @brief Exact three way comparison of the x (or y) coordinates of two events
+            int compare(const Event &a, const Event &b, bool y) const
+            {
+                const double va = y ? a.y : a.x, vb = y ? b.y : b.x;
+                if ((a.error == 0.0 && b.error == 0.0) || std::abs(va - vb) > 2 * (a.error + b.error))
+                    return va < vb ? -1 : (va > vb ? 1 : 0);
+
+                ExactValue numA, denA, numB, denB;
+                exactCoordinate(a, y, numA, denA);
+                exactCoordinate(b, y, numB, denB);
+                ExactValue diff = numA * denB;
+                diff -= numB * denA;
+                return diff.sign();
+            }
+
+            /// @brief Returns -1 if segment i passes below the current event, 0 if through it and 1 if above it
+            int position(std::size_t i) const
+            {
+                const Seg &s = _segs[i];
+                if (_event.error == 0.0)
+                    return -static_cast<int>(Geometry::orient2d(Vector2<double>(s.ax, s.ay), Vector2<double>(s.bx, s.by), Vector2<double>(_event.x, _event.y)));
+
+                const double rx = s.bx - s.ax, ry = s.by - s.ay;
+                const double dx = _event.x - s.ax, dy = _event.y - s.ay;
+                const double det = rx * dy - ry * dx;
+                const double bound = 2 * (std::abs(rx) + std::abs(ry)) * _event.error + 8 * epsilon * (std::abs(rx * dy) + std::abs(ry * dx));
+                if (std::abs(det) > bound)
+                    return det > 0 ? -1 : 1;
+
+                if (!_exactEvent)
+                    _exactEvent = intersection(_event.s, _event.t);
+                const Rational &p = *_exactEvent;
+                ExactValue py = p.y, px = p.x;
+                py -= ExactValue(s.ay) * p.d;
+                px -= ExactValue(s.ax) * p.d;
+                ExactValue exact = ExactValue::difference(s.bx, s.ax) * py;
+                exact -= ExactValue::difference(s.by, s.ay) * px;
+                return -exact.sign();
+            }
+
+            /// @brief Exact sign of the cross product of the directions of i and j, positive if j turns left of i
+            int turn(std::size_t i, std::size_t j) const
+            {
+                const Seg &s = _segs[i], &t = _segs[j];
+                const double left = (s.bx - s.ax) * (t.by - t.ay), right = (s.by - s.ay) * (t.bx - t.ax);
+                if (std::abs(left - right) > 8 * epsilon * (std::abs(left) + std::abs(right)))
+                    return left > right ? 1 : -1;
+
+                ExactValue exact = ExactValue::difference(s.bx, s.ax) * ExactValue::difference(t.by, t.ay);
+                exact -= ExactValue::difference(s.by, s.ay) * ExactValue::difference(t.bx, t.ax);
+                return exact.sign();
+            }
+
+            void findEvent(std::size_t i, std::size_t j)
+            {
+                // Collinear overlaps meet at an endpoint, which is an event already
+                if (!intersects(segment(i), segment(j)) || turn(i, j) == 0)
+                    return;
+
+                const Rational p = intersection(i, j);
+                const double d = p.d.estimate();
+                const double x = p.x.estimate() / d, y = p.y.estimate() / d;
+                const Event e{x, y, 16 * epsilon * (std::abs(x) + std::abs(y)) + std::numeric_limits<double>::denorm_min(), i, j};
+
+                if (EventLess{this}(_event, e))
+                    _events.try_emplace(e);
+            }
+
+            void report(const std::vector<std::size_t> &involved)
+            {
+                for (std::size_t a = 0; a < involved.size(); a++)
+                    for (std::size_t b = a + 1; b < involved.size(); b++)
+                    {
+                        const std::size_t i = std::min(involved[a], involved[b]);
+                        const std::size_t j = std::max(involved[a], involved[b]);
+                        if (!intersects(segment(i), segment(j)) || !_reported.insert(std::uint64_t(i) * _segs.size() + j).second)
+                            continue;
+                        _result.points.push_back(static_cast<IntersectionPoint<T>>(Vector2<double>(_event.x, _event.y)));
+                        _result.pairs.emplace_back(i, j);
+                    }
+            }
+
+            void handle(const Event &p, const std::vector<std::size_t> &upper)
+            {
+                _event = p;
+                _exactEvent.reset();
+
+                // Segments in the status containing p form a contiguous range, they either end at p or cross it.
+                // Intersection events never coincide with an endpoint, those are merged into the endpoint event.
+                auto [lo, hi] = _status.equal_range(AtEvent{});
+                std::vector<std::size_t> involved(upper);
+                std::vector<std::size_t> reinsert;
+                for (auto it = lo; it != hi; ++it)
+                {
+                    involved.push_back(*it);
+                    if (p.s != none || _segs[*it].bx != p.x || _segs[*it].by != p.y)
+                        reinsert.push_back(*it);
+                }
+                report(involved);
+
+                _status.erase(lo, hi);
+                for (std::size_t i : upper)
+                    if (_segs[i].ax != _segs[i].bx || _segs[i].ay != _segs[i].by)
+                        reinsert.push_back(i);
+                for (std::size_t i : reinsert)
+                    _status.insert(i);
+
+                std::tie(lo, hi) = _status.equal_range(AtEvent{});
+                if (lo != _status.begin() && lo != _status.end() && lo == hi)
+                    findEvent(*std::prev(lo), *lo);
+                if (lo != hi)
+                {
+                    if (lo != _status.begin())
+                        findEvent(*std::prev(lo), *lo);
+                    if (hi != _status.end())
+                        findEvent(*std::prev(hi), *hi);
+                }
+            }
+
+        public:
+            explicit Sweep(std::span<const Segment2<T>> input)
+                : _events(EventLess{this}), _status(Compare{this})
+            {
+                _segs.reserve(input.size());
+                for (std::size_t i = 0; i < input.size(); i++)
+                {
+                    Seg s{double(input[i].a.x), double(input[i].a.y), double(input[i].b.x), double(input[i].b.y)};
+                    if (s.bx < s.ax || (s.bx == s.ax && s.by < s.ay))
+                        s = Seg{s.bx, s.by, s.ax, s.ay};
+                    _segs.push_back(s);
+                    _events[Event{s.ax, s.ay}].push_back(i);
+                    _events.try_emplace(Event{s.bx, s.by});
+                }
+            }
+
+            Sweep(const Sweep &) = delete;
+            Sweep &operator=(const Sweep &) = delete;
+
+            IntersectionList<T> run()
+            {
+                while (!_events.empty())
+                {
+                    auto node = _events.extract(_events.begin());
+                    handle(node.key(), node.mapped());
+                }
+                return std::move(_result);
+            }
+        };
+    }
+
+    /// @brief Returns all intersecting pairs using a Bentley-Ottmann sweep line in O((n + k) log n)
+    /// @details Pairs crossing in a common point are all reported with that point, overlapping collinear
+    /// segments are reported once. All predicates are exact, so the pairs match allPairs() for any coordinates;
+    /// only the reported points are rounded.
+    template <typename T>
+    [[nodiscard]] IntersectionList<T> sweep(std::span<const Segment2<T>> segments)
+    {
+        return detail::Sweep<T>(segments).run();
+    }
+}
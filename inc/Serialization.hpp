@@ -0,0 +1,264 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+
+#include "Vector2.hpp"
+
+namespace Serial
+{
+    /// @brief Text layouts supported by the bulk formatter
+    enum class Format
+    {
+        CSV,        ///< One "x,y" pair per line
+        Whitespace, ///< One "x y" pair per line
+        JSON        ///< A single JSON array of [x,y] arrays
+    };
+
+    namespace detail
+    {
+        /// @brief Upper bound of characters std::to_chars needs for a single component
+        template <typename T>
+        constexpr std::size_t maxChars()
+        {
+            if constexpr (std::is_floating_point_v<T>)
+                return std::numeric_limits<T>::max_digits10 + 9; // sign, '.', 'e', exponent sign and up to 5 exponent digits
+            else
+                return std::numeric_limits<T>::digits10 + 3;
+        }
+
+        /// @brief Writes a single component, using the shortest round-trip representation for floating point types
+        template <typename T>
+        char *writeValue(char *first, char *last, T value)
+        {
+            const auto res = std::to_chars(first, last, value);
+            if (res.ec != std::errc())
+                throw std::runtime_error("Serialization buffer too small");
+            return res.ptr;
+        }
+
+        /// @brief Appends the vectors without the enclosing JSON brackets
+        /// @param leadingComma Whether the first JSON element has to be separated from a previous chunk
+        template <typename T>
+        void appendRange(std::string &out, std::span<const Vector2<T>> vectors, Format format, bool leadingComma)
+        {
+            const std::size_t start = out.size();
+            out.resize(start + vectors.size() * (2 * maxChars<T>() + 4));
+
+            char *it = out.data() + start;
+            char *const last = out.data() + out.size();
+
+            for (const Vector2<T> &v : vectors)
+            {
+                switch (format)
+                {
+                case Format::CSV:
+                    it = writeValue(it, last, v.x);
+                    *it++ = ',';
+                    it = writeValue(it, last, v.y);
+                    *it++ = '\n';
+                    break;
+                case Format::Whitespace:
+                    it = writeValue(it, last, v.x);
+                    *it++ = ' ';
+                    it = writeValue(it, last, v.y);
+                    *it++ = '\n';
+                    break;
+                case Format::JSON:
+                    if (leadingComma)
+                        *it++ = ',';
+                    leadingComma = true;
+                    *it++ = '[';
+                    it = writeValue(it, last, v.x);
+                    *it++ = ',';
+                    it = writeValue(it, last, v.y);
+                    *it++ = ']';
+                    break;
+                }
+            }
+
+            out.resize(it - out.data());
+        }
+    }
+
+    /// @brief Appends the text representation of all vectors to out
+    /// @details Uses std::to_chars, so no locale is involved and floating point values round-trip exactly.
+    /// Non-finite values are written as "nan"/"inf", which is not valid JSON but is accepted by StreamParser.
+    template <typename T>
+    void appendTo(std::string &out, std::span<const Vector2<T>> vectors, Format format)
+    {
+        if (format == Format::JSON)
+            out.push_back('[');
+        detail::appendRange(out, vectors, format, false);
+        if (format == Format::JSON)
+            out.push_back(']');
+    }
+
+    /// @brief Returns the text representation of all vectors
+    template <typename T>
+    [[nodiscard]] std::string format(std::span<const Vector2<T>> vectors, Format format)
+    {
+        std::string out;
+        appendTo(out, vectors, format);
+        return out;
+    }
+
+    /// @brief Writes the text representation of all vectors to os
+    /// @param chunkSize Number of vectors that are formatted into the intermediate buffer per write
+    template <typename T>
+    void writeTo(std::ostream &os, std::span<const Vector2<T>> vectors, Format format, std::size_t chunkSize = 1 << 14)
+    {
+        std::string buffer;
+        buffer.reserve(chunkSize * (2 * detail::maxChars<T>() + 4));
+
+        if (format == Format::JSON)
+            os.put('[');
+        for (std::size_t i = 0; i < vectors.size(); i += chunkSize)
+        {
+            buffer.clear();
+            detail::appendRange(buffer, vectors.subspan(i, std::min(chunkSize, vectors.size() - i)), format, i != 0);
+            os.write(buffer.data(), buffer.size());
+        }
+        if (format == Format::JSON)
+            os.put(']');
+    }
+
+    /// @brief Incremental parser turning chunks of text into Vector2 values
+    /// @details Numbers may be separated by whitespace, ',', '[' or ']', so the output of all Formats is accepted.
+    /// Numbers split by a chunk boundary are carried over to the next call of feed().
+    template <typename T>
+    class StreamParser
+    {
+    private:
+        std::string _carry;
+        T _pendingX{};
+        bool _hasPendingX = false;
+
+        static constexpr bool isSeparator(char c)
+        {
+            return c == ' ' || c == ',' || c == '\n' || c == '\r' || c == '\t' || c == '[' || c == ']';
+        }
+
+        void consume(std::string_view token, std::vector<Vector2<T>> &out)
+        {
+            T value;
+            const auto res = std::from_chars(token.data(), token.data() + token.size(), value);
+            if (res.ec != std::errc() || res.ptr != token.data() + token.size())
+                throw std::runtime_error("Invalid number \"" + std::string(token) + "\"");
+
+            if (_hasPendingX)
+                out.emplace_back(_pendingX, value);
+            else
+                _pendingX = value;
+            _hasPendingX = !_hasPendingX;
+        }
+
+    public:
+        /// @brief Parses the next chunk of text and appends all completed vectors to out
+        void feed(std::string_view chunk, std::vector<Vector2<T>> &out)
+        {
+            std::size_t pos = 0;
+
+            if (!_carry.empty())
+            {
+                while (pos < chunk.size() && !isSeparator(chunk[pos]))
+                    ++pos;
+                _carry.append(chunk.substr(0, pos));
+                if (pos == chunk.size())
+                    return;
+                consume(_carry, out);
+                _carry.clear();
+            }
+
+            while (true)
+            {
+                while (pos < chunk.size() && isSeparator(chunk[pos]))
+                    ++pos;
+                if (pos == chunk.size())
+                    return;
+
+                const std::size_t begin = pos;
+                while (pos < chunk.size() && !isSeparator(chunk[pos]))
+                    ++pos;
+                if (pos == chunk.size())
+                {
+                    _carry.assign(chunk.substr(begin));
+                    return;
+                }
+                consume(chunk.substr(begin, pos - begin), out);
+            }
+        }
+
+        /// @brief Signals the end of the input, flushing a number that was still carried over
+        void finish(std::vector<Vector2<T>> &out)
+        {
+            if (!_carry.empty())
+            {
+                consume(_carry, out);
+                _carry.clear();
+            }
+            if (_hasPendingX)
+            {
+                _hasPendingX = false;
+                throw std::runtime_error("Odd number of components");
+            }
+        }
+    };
+
+    /// @brief Parses all vectors contained in text
+    template <typename T>
+    [[nodiscard]] std::vector<Vector2<T>> parse(std::string_view text)
+    {
+        std::vector<Vector2<T>> out;
+        StreamParser<T> parser;
+        parser.feed(text, out);
+        parser.finish(out);
+        return out;
+    }
+
+    /// @brief Reads is chunk by chunk, handing every batch of parsed vectors to onChunk
+    /// @param onChunk Callable taking a std::span<const Vector2<T>>, the span is only valid during the call
+    /// @param chunkBytes Number of bytes read from the stream at once
+    template <typename T, typename F>
+    void readChunks(std::istream &is, F &&onChunk, std::size_t chunkBytes = 1 << 20)
+    {
+        std::string buffer(chunkBytes, '\0');
+        std::vector<Vector2<T>> out;
+        StreamParser<T> parser;
+
+        while (is)
+        {
+            is.read(buffer.data(), buffer.size());
+            parser.feed(std::string_view(buffer.data(), is.gcount()), out);
+            if (!out.empty())
+            {
+                onChunk(std::span<const Vector2<T>>(out));
+                out.clear();
+            }
+        }
+
+        parser.finish(out);
+        if (!out.empty())
+            onChunk(std::span<const Vector2<T>>(out));
+    }
+
+    /// @brief Reads all vectors contained in is
+    template <typename T>
+    [[nodiscard]] std::vector<Vector2<T>> readFrom(std::istream &is, std::size_t chunkBytes = 1 << 20)
+    {
+        std::vector<Vector2<T>> ret;
+        readChunks<T>(is, [&ret](std::span<const Vector2<T>> chunk)
+                      { ret.insert(ret.end(), chunk.begin(), chunk.end()); },
+                      chunkBytes);
+        return ret;
+    }
+}
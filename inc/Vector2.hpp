@@ -7,6 +7,7 @@
 #include <iostream>
 
 #include "Angle.hpp"
+#include "Instrumentation.hpp"
 
 template <typename T>
 struct Vector2
@@ -56,12 +57,14 @@ struct Vector2
     /// @brief Returns the angle of the Vector2
     [[nodiscard]] constexpr Angle getAngle() const
     {
+        VECTOR2_COUNT(Atan2, 1);
         return radians(std::atan2(y, x));
     }
 
     /// @brief Returns the length of the Vector2
     [[nodiscard]] constexpr T getLength() const
     {
+        VECTOR2_COUNT(Sqrt, 1);
         return std::sqrt(x * x + y * y);
     }
 
@@ -70,6 +73,8 @@ struct Vector2
     {
         double len = getLength();
 
+        VECTOR2_COUNT(Cos, 1);
+        VECTOR2_COUNT(Sin, 1);
         x = len * cos(ang.getRadians());
         y = len * sin(ang.getRadians());
 
@@ -81,6 +86,8 @@ struct Vector2
     {
         Angle ang = getAngle();
 
+        VECTOR2_COUNT(Cos, 1);
+        VECTOR2_COUNT(Sin, 1);
         x = len * cos(ang.getRadians());
         y = len * sin(ang.getRadians());
 
@@ -103,6 +110,8 @@ struct Vector2
     /// @brief Returns a Copy of the vector rotated by ang
     [[nodiscard]] constexpr Vector2<T> getRotated(Angle ang)
     {
+        VECTOR2_COUNT(Cos, 1);
+        VECTOR2_COUNT(Sin, 1);
         const float cosine = cos(ang.getRadians());
         const float sine = sin(ang.getRadians());
 
@@ -214,6 +223,7 @@ constexpr Vector2<Ta> operator*=(Vector2<Ta> &a, const Vector2<Tb> &b)
 template <typename Ta, typename Tb>
 [[nodiscard]] constexpr Vector2<typename std::common_type<Ta, Tb>::type> operator/(const Vector2<Ta> &a, const Vector2<Tb> &b)
 {
+    VECTOR2_COUNT(Division, 1);
     if (b.x == 0 || b.y == 0)
         throw std::runtime_error("Division by Zero");
     return Vector2(a.x / b.x, a.y / b.y);
@@ -223,6 +233,7 @@ template <typename Ta, typename Tb>
 template <typename Ta, typename Tb>
 constexpr Vector2<Ta> operator/=(Vector2<Ta> &a, const Vector2<Tb> &b)
 {
+    VECTOR2_COUNT(Division, 1);
     if (b.x == 0 || b.y == 0)
         throw std::runtime_error("Division by Zero");
     a.x /= b.x;
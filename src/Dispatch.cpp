@@ -0,0 +1,98 @@
+#include "../inc/Dispatch.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace Dispatch
+{
+    namespace detail
+    {
+        extern const KernelTable baselineKernels;
+#ifdef VECTOR2_X86_LEVELS
+        extern const KernelTable v3Kernels;
+        extern const KernelTable v4Kernels;
+#endif
+    }
+
+    const char *isaName(IsaLevel level)
+    {
+        switch (level)
+        {
+        case IsaLevel::X86_64_v3:
+            return "x86-64-v3";
+        case IsaLevel::X86_64_v4:
+            return "x86-64-v4";
+        default:
+            return "baseline";
+        }
+    }
+
+    std::optional<IsaLevel> parseIsa(std::string_view name)
+    {
+        if (name == "baseline")
+            return IsaLevel::Baseline;
+        if (name == "x86-64-v3" || name == "v3")
+            return IsaLevel::X86_64_v3;
+        if (name == "x86-64-v4" || name == "v4")
+            return IsaLevel::X86_64_v4;
+        return std::nullopt;
+    }
+
+    IsaLevel detectIsa()
+    {
+#ifdef VECTOR2_X86_LEVELS
+        // The level names check every feature -march=x86-64-v3/v4 may use (including MOVBE, LZCNT, F16C, POPCNT
+        // and SSE4), and via xgetbv that the OS saves the AVX and AVX-512 registers
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("x86-64-v4"))
+            return IsaLevel::X86_64_v4;
+        if (__builtin_cpu_supports("x86-64-v3"))
+            return IsaLevel::X86_64_v3;
+#endif
+        return IsaLevel::Baseline;
+    }
+
+    IsaLevel selectIsa(std::string_view requested, IsaLevel detected)
+    {
+        const auto level = parseIsa(requested);
+        if (!level)
+            throw std::runtime_error("Unknown VECTOR2_ISA level \"" + std::string(requested) + "\"");
+        return std::min(*level, detected);
+    }
+
+    IsaLevel activeIsa()
+    {
+        static const IsaLevel level = []
+        {
+            const char *env = std::getenv("VECTOR2_ISA");
+            return env ? selectIsa(env, detectIsa()) : detectIsa();
+        }();
+        return level;
+    }
+
+    const KernelTable &kernels(IsaLevel level)
+    {
+        if (level > detectIsa())
+            throw std::runtime_error(std::string("ISA level ") + isaName(level) + " not supported");
+
+        switch (level)
+        {
+#ifdef VECTOR2_X86_LEVELS
+        case IsaLevel::X86_64_v4:
+            return detail::v4Kernels;
+        case IsaLevel::X86_64_v3:
+            return detail::v3Kernels;
+#endif
+        default:
+            return detail::baselineKernels;
+        }
+    }
+
+    const KernelTable &kernels()
+    {
+        static const KernelTable &table = kernels(activeIsa());
+        return table;
+    }
+}
@@ -0,0 +1,26 @@
+// Compiled once per ISA level, see CMakeLists.txt. VECTOR2_KERNEL_NAMESPACE gives the header kernels of every
+// level distinct symbols, otherwise the linker could merge them and run AVX-512 code on a baseline CPU.
+// For the same reason only the restrict-qualified raw pointer kernels may be instantiated here, and they may only
+// call helpers that are always inlined (KernelMath) or live in the same namespace. The KernelSymbols tests check
+// that the object defines no other global symbols.
+
+#include "../inc/Dispatch.hpp"
+#include "../inc/Integrator.hpp"
+#include "../inc/Binning.hpp"
+
+namespace Dispatch::detail
+{
+    extern const KernelTable VECTOR2_KERNEL_TABLE;
+
+    const KernelTable VECTOR2_KERNEL_TABLE = {
+        IsaLevel::VECTOR2_KERNEL_LEVEL,
+        &Integrate::detail::eulerKernel<false, float>,
+        &Integrate::detail::eulerKernel<true, float>,
+        &Integrate::detail::semiImplicitEulerKernel<false, float>,
+        &Integrate::detail::semiImplicitEulerKernel<true, float>,
+        &Integrate::detail::verletPositionsKernel<float>,
+        &Integrate::detail::verletVelocitiesKernel<false, float>,
+        &Integrate::detail::verletVelocitiesKernel<true, float>,
+        &Binning::detail::cellIndexKernel<float>,
+    };
+}
@@ -1,6 +1,21 @@
 #include <gtest/gtest.h>
 #include <iostream>
 #include "../inc/Vector2.hpp"
+#include "../inc/Serialization.hpp"
+#include "../inc/Geometry.hpp"
+#include "../inc/SegmentIntersection.hpp"
+#include "../inc/Broadphase.hpp"
+#include "../inc/Integrator.hpp"
+#include "../inc/Ranges.hpp"
+#include "../inc/Interpolation.hpp"
+#include "../inc/Polyline.hpp"
+#include "../inc/Binning.hpp"
+#include "../inc/Dispatch.hpp"
+#include <numeric>
+#include <random>
+#include <set>
+#include <thread>
+#include <sstream>
 
 class Vectors : public testing::Test
 {
@@ -127,6 +142,708 @@ TEST_F(Vectors, GetLength)
     EXPECT_EQ(v_i_3_4.getLength(), 5);
 }
 
+TEST(Serialization, FormatCSV)
+{
+    std::vector<Vector2i> v{{1, 2}, {-3, 4}};
+
+    EXPECT_EQ(Serial::format<int>(v, Serial::Format::CSV), "1,2\n-3,4\n");
+    EXPECT_EQ(Serial::format<int>(v, Serial::Format::Whitespace), "1 2\n-3 4\n");
+    EXPECT_EQ(Serial::format<int>(v, Serial::Format::JSON), "[[1,2],[-3,4]]");
+}
+
+TEST(Serialization, RoundTrip)
+{
+    std::vector<Vector2d> v{{0.1, -2.5e-300}, {1.0 / 3.0, 12345.678}};
+
+    for (auto format : {Serial::Format::CSV, Serial::Format::Whitespace, Serial::Format::JSON})
+        EXPECT_EQ(Serial::parse<double>(Serial::format<double>(v, format)), v);
+}
+
+TEST(Serialization, ChunkedStream)
+{
+    std::vector<Vector2f> v;
+    for (int i = 0; i < 1000; i++)
+        v.emplace_back(i * 0.37f, -i / 7.f);
+
+    std::stringstream ss;
+    Serial::writeTo<float>(ss, v, Serial::Format::JSON, 64);
+
+    EXPECT_EQ(Serial::readFrom<float>(ss, 7), v);
+}
+
+TEST(Serialization, ParseErrors)
+{
+    EXPECT_THROW((void)Serial::parse<float>("1,2,3"), std::runtime_error);
+    EXPECT_THROW((void)Serial::parse<float>("1,abc"), std::runtime_error);
+}
+
+TEST(Geometry, SignedArea)
+{
+    std::vector<Vector2d> square{{0, 0}, {2, 0}, {2, 2}, {0, 2}};
+    std::vector<Vector2d> reversed(square.rbegin(), square.rend());
+
+    EXPECT_EQ(Geometry::signedArea<double>(square), 4.0);
+    EXPECT_EQ(Geometry::signedArea<double>(reversed), -4.0);
+    EXPECT_EQ(Geometry::orientation<double>(square), Geometry::Orientation::CounterClockwise);
+    EXPECT_EQ(Geometry::orientation<double>(reversed), Geometry::Orientation::Clockwise);
+}
+
+TEST(Geometry, RobustOrientation)
+{
+    // Points within a few ulps of the line y = x, where a naive determinant gives inconsistent signs
+    const Vector2d b(12, 12), c(24, 24);
+    for (int i = 0; i < 8; i++)
+        for (int j = 0; j < 8; j++)
+        {
+            const Vector2d a(0.5 + i * std::ldexp(1.0, -53), 0.5 + j * std::ldexp(1.0, -53));
+            const auto expected = j > i ? Geometry::Orientation::CounterClockwise
+                                        : (j < i ? Geometry::Orientation::Clockwise : Geometry::Orientation::Collinear);
+            EXPECT_EQ(Geometry::orient2d(b, c, a), expected);
+        }
+}
+
+// Winding number with the same half-open rule as the crossing test: an edge counts for the points whose y lies in
+// [min y, max y) of the edge and that lie strictly left of it when walking upwards
+static int windingNumber(std::span<const Vector2f> polygon, const Vector2f &p)
+{
+    int winding = 0;
+    for (std::size_t i = 0; i < polygon.size(); i++)
+    {
+        const Vector2f &a = polygon[i], &b = polygon[(i + 1) % polygon.size()];
+        if (a.y <= p.y && p.y < b.y && Geometry::orient2d(a, b, p) == Geometry::Orientation::CounterClockwise)
+            winding++;
+        else if (b.y <= p.y && p.y < a.y && Geometry::orient2d(a, b, p) == Geometry::Orientation::Clockwise)
+            winding--;
+    }
+    return winding;
+}
+
+TEST(Geometry, PointInPolygon)
+{
+    // Slanted edges with slope +-1 and a horizontal notch, so the grid below hits vertices, horizontal edges
+    // and slanted edges exactly
+    std::vector<Vector2f> polygon{{0, 0}, {4, 0}, {4, 4}, {3, 3}, {1, 3}, {0, 4}};
+    std::vector<Vector2f> points;
+    for (int y = -16; y <= 80; y++)
+        for (int x = -16; x <= 80; x++)
+            points.emplace_back(x / 16.0f, y / 16.0f);
+
+    std::vector<std::uint8_t> inside(points.size());
+    Geometry::contains<float>(polygon, points, inside);
+
+    for (std::size_t i = 0; i < points.size(); i++)
+        EXPECT_EQ(bool(inside[i]), windingNumber(polygon, points[i]) != 0) << points[i].x << ", " << points[i].y;
+    EXPECT_TRUE(Geometry::contains<float>(polygon, Vector2f(1, 0.5f)));
+    EXPECT_TRUE(Geometry::contains<float>(polygon, Vector2f(0.5f, 3.25f)));
+    EXPECT_FALSE(Geometry::contains<float>(polygon, Vector2f(2, 3.5f)));
+    EXPECT_FALSE(Geometry::contains<float>(polygon, Vector2f(5, 1)));
+}
+
+TEST(Geometry, ConvexHull)
+{
+    std::vector<Vector2i> points;
+    for (int x = 0; x <= 100; x++)
+        for (int y = 0; y <= 100; y++)
+            points.emplace_back(x, y);
+
+    std::vector<Vector2i> expected{{0, 0}, {100, 0}, {100, 100}, {0, 100}};
+    EXPECT_EQ(Geometry::convexHull<int>(points), expected);
+}
+
+TEST(Segments, Intersect)
+{
+    const Segment2<int> s({0, 0}, {4, 4});
+
+    EXPECT_EQ(*intersect(s, Segment2<int>({0, 4}, {4, 0})), Vector2d(2, 2));
+    EXPECT_EQ(*intersect(s, Segment2<int>({2, 2}, {6, 6})), Vector2d(2, 2));
+    EXPECT_EQ(*intersect(s, Segment2<int>({4, 4}, {5, 0})), Vector2d(4, 4));
+    EXPECT_FALSE(intersect(s, Segment2<int>({1, 0}, {5, 4})));
+    EXPECT_FALSE(intersect(s, Segment2<int>({5, 5}, {6, 6})));
+}
+
+TEST(Segments, NearlyParallelSharedEndpoint)
+{
+    // Pairs (a, b) and (c, b) meeting at a tiny angle, where the rounding error of the parametric prefilter is far
+    // larger than its denominator
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> position(-1000.0, 1000.0), length(1.0, 100.0), angle(-1e-6, 1e-6), direction(0.0, 6.283);
+    std::vector<Segment2<double>> segments;
+    for (int i = 0; i < 2000; i++)
+    {
+        const Vector2d b(position(gen), position(gen));
+        const double phi = direction(gen), psi = phi + angle(gen);
+        const Vector2d a = b + Vector2d(std::cos(phi), std::sin(phi)) * Vector2d(length(gen));
+        const Vector2d c = b + Vector2d(std::cos(psi), std::sin(psi)) * Vector2d(length(gen));
+        segments.emplace_back(a, b);
+        segments.emplace_back(c, b);
+    }
+
+    std::set<std::pair<std::size_t, std::size_t>> expected;
+    for (std::size_t i = 0; i < segments.size(); i++)
+        for (std::size_t j = i + 1; j < segments.size(); j++)
+            if (intersects(segments[i], segments[j]))
+                expected.emplace(i, j);
+
+    const auto brute = Segments::allPairs<double>(segments);
+    EXPECT_GE(expected.size(), 2000u);
+    EXPECT_EQ(std::set(brute.pairs.begin(), brute.pairs.end()), expected);
+}
+
+TEST(Segments, SweepMatchesAllPairs)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(0.f, 100.f);
+    std::vector<Segment2<float>> segments;
+    for (int i = 0; i < 400; i++)
+    {
+        const Vector2f a(dist(gen), dist(gen));
+        segments.emplace_back(a, a + Vector2f(dist(gen), dist(gen)) * Vector2f(0.2f) - Vector2f(10.f));
+    }
+    // A grid of horizontal and vertical segments touching at their endpoints
+    for (int i = 0; i < 10; i++)
+    {
+        segments.emplace_back(Vector2f(0, i * 10.f), Vector2f(90, i * 10.f));
+        segments.emplace_back(Vector2f(i * 10.f, 0), Vector2f(i * 10.f, 90));
+    }
+
+    const auto brute = Segments::allPairs<float>(segments);
+    const auto swept = Segments::sweep<float>(segments);
+
+    EXPECT_GT(brute.size(), 100u);
+    EXPECT_EQ(std::set(brute.pairs.begin(), brute.pairs.end()), std::set(swept.pairs.begin(), swept.pairs.end()));
+    EXPECT_EQ(swept.points.size(), swept.pairs.size());
+}
+
+TEST(Segments, SweepFarFromOrigin)
+{
+    // Short segments at world coordinates, where the rounded intersection points are far less precise than the segments
+    for (const double offset : {1e4, 1e6, 1e9})
+        for (unsigned int seed = 0; seed < 50; seed++)
+        {
+            std::mt19937 gen(seed);
+            std::uniform_real_distribution<double> position(0.0, 60.0), direction(-10.0, 10.0);
+            std::vector<Segment2<double>> segments;
+            for (int i = 0; i < 60; i++)
+            {
+                const Vector2d a(offset + position(gen), offset + position(gen));
+                segments.emplace_back(a, a + Vector2d(direction(gen), direction(gen)));
+                if (i % 10 == 0)
+                    segments.emplace_back(a, a + Vector2d(0, direction(gen)));
+            }
+
+            const auto brute = Segments::allPairs<double>(segments);
+            const auto swept = Segments::sweep<double>(segments);
+            ASSERT_EQ(std::set(brute.pairs.begin(), brute.pairs.end()), std::set(swept.pairs.begin(), swept.pairs.end())) << offset << " " << seed;
+            ASSERT_EQ(swept.points.size(), brute.size());
+        }
+}
+
+TEST(Segments, SweepCommonPoint)
+{
+    std::vector<Segment2<double>> star;
+    for (int i = 0; i < 8; i++)
+    {
+        const Vector2d d = Vector2d(1, 0).getRotated(degrees(i * 22.5f));
+        star.emplace_back(Vector2d(5, 5) - d, Vector2d(5, 5) + d);
+    }
+
+    const auto swept = Segments::sweep<double>(star);
+    ASSERT_EQ(swept.size(), 28u);
+    for (const Vector2d &p : swept.points)
+        EXPECT_NEAR((p - Vector2d(5, 5)).getLength(), 0.0, 1e-9);
+}
+
+TEST(Broadphase, SortAndSweepMatchesBruteForce)
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> pos(0.f, 1000.f), size(1.f, 20.f), step(-2.f, 2.f);
+    std::vector<AABB2f> boxes;
+    for (int i = 0; i < 3000; i++)
+    {
+        const Vector2f min(pos(gen), pos(gen));
+        boxes.emplace_back(min, min + Vector2f(size(gen), size(gen)));
+    }
+
+    Broadphase::SortAndSweep<float> broadphase;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        std::set<Broadphase::Pair> expected;
+        for (std::uint32_t i = 0; i < boxes.size(); i++)
+            for (std::uint32_t j = i + 1; j < boxes.size(); j++)
+                if (boxes[i].overlaps(boxes[j]))
+                    expected.emplace(i, j);
+
+        const auto &pairs = broadphase.update(boxes);
+        EXPECT_EQ(pairs.size(), expected.size());
+        EXPECT_EQ(std::set(pairs.begin(), pairs.end()), expected);
+
+        for (AABB2f &box : boxes)
+            box = box.getTranslated(Vector2f(step(gen), step(gen)));
+    }
+}
+
+TEST(Broadphase, PermutedBoxes)
+{
+    std::mt19937 gen(8);
+    std::uniform_real_distribution<float> pos(0.f, 1000.f), size(1.f, 20.f);
+    std::vector<AABB2f> boxes;
+    for (int i = 0; i < 3000; i++)
+    {
+        const Vector2f min(pos(gen), pos(gen));
+        boxes.emplace_back(min, min + Vector2f(size(gen), size(gen)));
+    }
+
+    // Same number of boxes, but their indices are shuffled between frames, so the kept order is useless
+    Broadphase::SortAndSweep<float> broadphase;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        std::set<Broadphase::Pair> expected;
+        for (std::uint32_t i = 0; i < boxes.size(); i++)
+            for (std::uint32_t j = i + 1; j < boxes.size(); j++)
+                if (boxes[i].overlaps(boxes[j]))
+                    expected.emplace(i, j);
+
+        const auto &pairs = broadphase.update(boxes);
+        EXPECT_EQ(pairs.size(), expected.size());
+        EXPECT_EQ(std::set(pairs.begin(), pairs.end()), expected);
+
+        std::shuffle(boxes.begin(), boxes.end(), gen);
+    }
+}
+
+TEST(Integrator, EulerMatchesScalar)
+{
+    Particles2<float> p;
+    std::vector<Vector2f> pos, vel;
+    for (int i = 0; i < 100; i++)
+    {
+        pos.emplace_back(i, -i);
+        vel.emplace_back(1, i * 0.5f);
+        p.push(pos.back(), vel.back(), Vector2f(0, -10));
+    }
+
+    const Integrate::Settings<float> settings{0.5f};
+    for (int step = 0; step < 4; step++)
+    {
+        Integrate::euler(p, settings);
+        for (std::size_t i = 0; i < pos.size(); i++)
+        {
+            pos[i] += vel[i] * Vector2f(settings.dt);
+            vel[i] += Vector2f(0, -10) * Vector2f(settings.dt);
+        }
+    }
+
+    for (std::size_t i = 0; i < pos.size(); i++)
+    {
+        EXPECT_EQ(p.getPosition(i), pos[i]);
+        EXPECT_EQ(p.getVelocity(i), vel[i]);
+    }
+}
+
+TEST(Integrator, SemiImplicitEuler)
+{
+    Particles2<double> p;
+    p.push(Vector2d(0, 0), Vector2d(1, 0), Vector2d(0, 2));
+
+    Integrate::semiImplicitEuler(p, {1.0});
+
+    EXPECT_EQ(p.getVelocity(0), Vector2d(1, 2));
+    EXPECT_EQ(p.getPosition(0), Vector2d(1, 2));
+}
+
+TEST(Integrator, VelocityVerletConstantAcceleration)
+{
+    Particles2<double> p;
+    p.push(Vector2d(0, 100), Vector2d(3, 0), Vector2d(0, -10));
+
+    const Integrate::Settings<double> settings{0.25};
+    for (int step = 0; step < 8; step++)
+        Integrate::velocityVerlet(p, settings, [](Particles2<double> &) {});
+
+    // Velocity Verlet is exact for constant accelerations
+    EXPECT_DOUBLE_EQ(p.getPosition(0).x, 6.0);
+    EXPECT_DOUBLE_EQ(p.getPosition(0).y, 100.0 - 0.5 * 10.0 * 2.0 * 2.0);
+    EXPECT_DOUBLE_EQ(p.getVelocity(0).y, -20.0);
+}
+
+TEST(Integrator, DampingAndSpeedLimit)
+{
+    Particles2<float> p;
+    p.push(Vector2f(0, 0), Vector2f(30, 40));
+    p.push(Vector2f(0, 0), Vector2f(1, 0));
+
+    Integrate::Settings<float> settings{0.1f};
+    settings.damping = 1.f;
+    settings.maxSpeed = 10.f;
+    Integrate::semiImplicitEuler(p, settings);
+
+    EXPECT_FLOAT_EQ(p.getVelocity(0).getLength(), 10.f);
+    EXPECT_FLOAT_EQ(p.getVelocity(0).x, 6.f);
+    EXPECT_FLOAT_EQ(p.getVelocity(1).x, 0.9f);
+}
+
+TEST(Integrator, ParallelMatchesSerial)
+{
+    Particles2<float> a;
+    for (int i = 0; i < 200000; i++)
+        a.push(Vector2f(i * 0.01f, 1), Vector2f(-1, i * 0.001f), Vector2f(0.5f, -1));
+    Particles2<float> b = a;
+
+    Integrate::Settings<float> settings{0.01f, 0.1f, 100.f};
+    Integrate::semiImplicitEuler(a, settings);
+    settings.parallel = false;
+    Integrate::semiImplicitEuler(b, settings);
+
+    EXPECT_EQ(a.px, b.px);
+    EXPECT_EQ(a.vy, b.vy);
+}
+
+TEST(Views, PipelineMatchesMemberFunctions)
+{
+    std::vector<Vector2f> points;
+    for (int i = 0; i < 100; i++)
+        points.emplace_back(i * 0.5f, 10.f - i);
+
+    auto pipeline = points | Views::rotated(30_deg) | Views::translated(Vector2f(1, -2)) | Views::scaled(3);
+    static_assert(std::is_same_v<std::remove_cvref_t<decltype(pipeline.op())>, Views::Affine<float>>);
+
+    std::size_t i = 0;
+    for (const Vector2f &v : pipeline)
+    {
+        const Vector2f expected = points[i++].getRotated(30_deg).getTranslated(Vector2f(1, -2)).getScaled(3);
+        EXPECT_NEAR(v.x, expected.x, 1e-3f);
+        EXPECT_NEAR(v.y, expected.y, 1e-3f);
+    }
+    EXPECT_EQ(i, points.size());
+    EXPECT_EQ(pipeline.size(), points.size());
+}
+
+TEST(Views, NormalizedAndLerped)
+{
+    std::vector<Vector2d> points{{3, 4}, {0, -2}, {10, 0}};
+
+    auto pipeline = points | Views::lerped(Vector2d(0, 0), 0.5) | Views::normalized | Views::scaled(2) | Views::translated(Vector2d(1, 1));
+    const std::vector<Vector2d> result = Views::toVector(pipeline);
+
+    ASSERT_EQ(result.size(), points.size());
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        const Vector2d expected = Interp::linear(points[i], Vector2d(0, 0), 0.5f).getNormalized().getScaled(2).getTranslated(Vector2d(1, 1));
+        EXPECT_NEAR(result[i].x, expected.x, 1e-12);
+        EXPECT_NEAR(result[i].y, expected.y, 1e-12);
+    }
+}
+
+TEST(Views, MaterializeMatchesLazyEvaluation)
+{
+    std::vector<Vector2f> points;
+    for (int i = 0; i < 100000; i++)
+        points.emplace_back(std::sin(i * 0.1f), i * 0.001f);
+
+    const auto stages = Views::rotated(-45_deg) | Views::scaled(0.5);
+    auto pipeline = points | stages;
+    std::vector<Vector2f> out(points.size());
+    Views::materialize(pipeline, std::span<Vector2f>(out));
+
+    EXPECT_TRUE(std::ranges::equal(out, pipeline));
+}
+
+TEST(Views, TemporaryContainer)
+{
+    const std::vector<Vector2f> points = {Vector2f(1, 0), Vector2f(0, 2), Vector2f(-3, 1)};
+
+    auto pipeline = std::vector<Vector2f>(points) | Views::rotated(degrees(90.f)) | Views::scaled(2);
+    const std::vector<Vector2f> rotated = Views::toVector(std::move(pipeline));
+    const std::vector<Vector2f> scaled = Views::toVector(std::vector<Vector2f>(points) | Views::scaled(2));
+
+    ASSERT_EQ(rotated.size(), points.size());
+    ASSERT_EQ(scaled.size(), points.size());
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        EXPECT_NEAR(rotated[i].x, -2 * points[i].y, 1e-5f);
+        EXPECT_NEAR(rotated[i].y, 2 * points[i].x, 1e-5f);
+        EXPECT_EQ(scaled[i], points[i] * Vector2f(2));
+    }
+}
+
+TEST(Instrumentation, CountsExpensiveCalls)
+{
+    const Instr::Snapshot before = Instr::threadSnapshot();
+    {
+        Instr::Region region("SetLengthAndDivide");
+        Vector2d v(3, 4);
+        v.setLength(10);
+        v /= Vector2d(2, 2);
+    }
+    const Instr::Snapshot delta = Instr::threadSnapshot() - before;
+
+#ifdef VECTOR2_INSTRUMENTATION
+    EXPECT_EQ(delta[Instr::Counter::Atan2], 1u);
+    EXPECT_EQ(delta[Instr::Counter::Cos], 1u);
+    EXPECT_EQ(delta[Instr::Counter::Sin], 1u);
+    EXPECT_EQ(delta[Instr::Counter::Sqrt], 0u);
+    EXPECT_EQ(delta[Instr::Counter::Division], 1u);
+    EXPECT_EQ(Instr::regions().at("SetLengthAndDivide")[Instr::Counter::Atan2], 1u);
+
+    const Instr::Snapshot total = Instr::snapshot();
+    std::thread([]
+                { (void)Vector2f(1, 1).getLength(); })
+        .join();
+    EXPECT_EQ((Instr::snapshot() - total)[Instr::Counter::Sqrt], 1u);
+
+    // Exited threads are folded into a retired total instead of staying registered
+    const std::size_t registered = Instr::detail::registry().threads.size();
+    for (int i = 0; i < 20; i++)
+        std::thread([]
+                    { (void)Vector2f(1, 1).getLength(); })
+            .join();
+    EXPECT_EQ(Instr::detail::registry().threads.size(), registered);
+    EXPECT_EQ((Instr::snapshot() - total)[Instr::Counter::Sqrt], 21u);
+#else
+    EXPECT_EQ(delta.counts, Instr::Snapshot().counts);
+    EXPECT_TRUE(Instr::regions().empty());
+#endif
+}
+
+TEST(Instrumentation, Json)
+{
+    Instr::Snapshot s;
+    s.counts = {1, 2, 3, 4, 5};
+
+    EXPECT_EQ(Instr::toJson(s), "{\"sqrt\":1,\"atan2\":2,\"sin\":3,\"cos\":4,\"division\":5}");
+    EXPECT_EQ(Instr::reportJson().rfind("{\"total\":{\"sqrt\":", 0), 0u);
+    EXPECT_EQ(Instr::escapeJson("a\"b\\c\n\x1f\xc3\xa9"), "a\\\"b\\\\c\\u000a\\u001f\xc3\xa9");
+#ifdef VECTOR2_INSTRUMENTATION
+    {
+        const Instr::Region region("tab\tname");
+    }
+    EXPECT_NE(Instr::reportJson().find("\"tab\\u0009name\":"), std::string::npos);
+#endif
+}
+
+TEST(Polyline, ArcLengthAndSampling)
+{
+    Polyline2d line;
+    line.append(Vector2d(0, 0));
+    line.append(Vector2d(3, 4));
+    line.append(Vector2d(3, 4));
+    line.append(Vector2d(3, 14));
+
+    EXPECT_EQ(line.getLength(), 15.0);
+    EXPECT_EQ(line.getArcLength(1), 5.0);
+    EXPECT_EQ(line.sampleAt(-1.0), Vector2d(0, 0));
+    EXPECT_EQ(line.sampleAt(2.5), Vector2d(1.5, 2));
+    EXPECT_EQ(line.sampleAt(5.0), Vector2d(3, 4));
+    EXPECT_EQ(line.sampleAt(10.0), Vector2d(3, 9));
+    EXPECT_EQ(line.sampleAt(100.0), Vector2d(3, 14));
+
+    const std::vector<Vector2d> samples = line.resample(5.0);
+    const std::vector<Vector2d> expected{{0, 0}, {3, 4}, {3, 9}, {3, 14}};
+    EXPECT_EQ(samples, expected);
+}
+
+TEST(Polyline, ResampleLongTrack)
+{
+    std::vector<Vector2d> points;
+    for (int i = 0; i <= 100000; i++)
+        points.emplace_back(i * 0.5, 0.0);
+    const Polyline2d line(points);
+
+    const std::vector<Vector2d> samples = line.resample(0.25);
+    ASSERT_EQ(samples.size(), 200001u);
+    for (std::size_t k = 0; k < samples.size(); k += 997)
+        EXPECT_DOUBLE_EQ(samples[k].x, k * 0.25);
+}
+
+TEST(Polyline, Simplify)
+{
+    // Sawtooth with small noise, only the tips have to survive
+    std::vector<Vector2d> points;
+    for (int i = 0; i <= 200000; i++)
+    {
+        const int phase = i % 100;
+        const double y = (phase < 50 ? phase : 100 - phase) + ((i * 7919) % 13) * 1e-3;
+        points.emplace_back(i, y);
+    }
+    const Polyline2d line(points);
+
+    const Polyline2d dp = line.simplifyDouglasPeucker(0.1);
+    ASSERT_EQ(dp.size(), 4001u);
+    for (std::size_t k = 0; k < dp.size(); k++)
+        EXPECT_EQ(dp.getPoints()[k].x, k * 50.0);
+
+    const Polyline2d vw = line.simplifyVisvalingam(1.0);
+    EXPECT_LT(vw.size(), 4100u);
+    EXPECT_GE(vw.size(), 4001u);
+    EXPECT_NEAR(vw.getLength(), dp.getLength(), 1.0);
+
+    // Chunks have a fixed length, so their boundaries and the result do not depend on the number of threads
+    for (const double boundary : {65536.0, 131072.0})
+        EXPECT_TRUE(std::ranges::any_of(vw.getPoints(), [boundary](const Vector2d &p)
+                                        { return p.x == boundary; }));
+}
+
+TEST(Binning, CellIndices)
+{
+    const Binning::Histogram2<float> grid(AABB2f(Vector2f(-1, 0), Vector2f(3, 2)), 4, 2);
+    EXPECT_EQ(grid.cellOf(Vector2f(-1, 0)), 0u);
+    EXPECT_EQ(grid.cellOf(Vector2f(0.5f, 0.5f)), 1u);
+    EXPECT_EQ(grid.cellOf(Vector2f(2.9f, 1.9f)), 7u);
+    EXPECT_EQ(grid.cellOf(Vector2f(3, 2)), 7u);
+    EXPECT_EQ(grid.cellOf(Vector2f(-50, 50)), 4u);
+    EXPECT_EQ(grid.cellOf(Vector2f(std::nanf(""), 0.5f)), 0u);
+    EXPECT_EQ(grid.getCellCenter(1, 1), Vector2f(0.5f, 1.5f));
+    EXPECT_THROW(Binning::Histogram2<float>(AABB2f(Vector2f(0, 0), Vector2f(0, 1)), 4, 2), std::runtime_error);
+    // A float cannot hold the last column index exactly, so it could round up to one past the grid
+    EXPECT_THROW(Binning::Histogram2<float>(AABB2f(Vector2f(0, 0), Vector2f(1, 1)), (1u << 26) - 1, 1), std::runtime_error);
+    EXPECT_THROW(Binning::Histogram2<float>(AABB2f(Vector2f(0, 0), Vector2f(1, 1)), 1, (1u << 24) + 1), std::runtime_error);
+}
+
+TEST(Binning, ParallelHistogramMatchesSerial)
+{
+    std::mt19937 gen(5);
+    std::normal_distribution<float> dist(0.0f, 2.0f);
+    std::vector<Vector2f> points(300000);
+    std::vector<double> weights(points.size());
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        points[i] = Vector2f(dist(gen), dist(gen));
+        weights[i] = double(i % 7);
+    }
+
+    const AABB2f bounds(Vector2f(-5, -5), Vector2f(5, 5));
+    Binning::Histogram2<float> counts(bounds, 64, 32), weighted(bounds, 64, 32);
+    counts.add(points);
+    weighted.add(points, std::span<const double>(weights));
+
+    std::vector<double> expected(64 * 32, 0.0), expectedWeighted(64 * 32, 0.0);
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        const int x = std::clamp(int(std::floor((points[i].x + 5) * 6.4f)), 0, 63);
+        const int y = std::clamp(int(std::floor((points[i].y + 5) * 3.2f)), 0, 31);
+        expected[y * 64 + x] += 1;
+        expectedWeighted[y * 64 + x] += weights[i];
+    }
+
+    // The reference computes the cells in the same float arithmetic and the weights are small integers, so the
+    // sums are exact regardless of how the points were split across threads
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(counts.getCells()[i], expected[i]);
+        EXPECT_EQ(weighted.getCells()[i], expectedWeighted[i]);
+    }
+    EXPECT_EQ(counts.getTotal(), double(points.size()));
+    EXPECT_THROW(weighted.add(points, std::span<const double>(weights).first(10)), std::runtime_error);
+
+    std::vector<double> densities(counts.getCells().size());
+    counts.getDensities(densities);
+    double integral = 0;
+    for (std::uint32_t row = 0; row < 32; row++)
+        for (std::uint32_t column = 0; column < 64; column++)
+        {
+            EXPECT_DOUBLE_EQ(densities[row * 64 + column], counts.getDensity(column, row));
+            integral += densities[row * 64 + column] * (10.0 / 64) * (10.0 / 32);
+        }
+    EXPECT_NEAR(integral, 1.0, 1e-6);
+    EXPECT_NEAR(weighted.getTotal(), std::accumulate(weights.begin(), weights.end(), 0.0), 1e-6);
+}
+
+TEST(Binning, BilinearSplat)
+{
+    Binning::Histogram2<double> grid(AABB2d(Vector2d(0, 0), Vector2d(4, 4)), 4, 4);
+    const std::vector<Vector2d> points = {Vector2d(1.5, 1.5), Vector2d(2, 1.5), Vector2d(-3, 10)};
+    grid.add(points, Binning::Splat::Bilinear);
+
+    EXPECT_DOUBLE_EQ(grid.getCell(1, 1), 1.5);
+    EXPECT_DOUBLE_EQ(grid.getCell(2, 1), 0.5);
+    EXPECT_DOUBLE_EQ(grid.getCell(0, 3), 1.0);
+    EXPECT_DOUBLE_EQ(grid.getTotal(), 3.0);
+}
+
+TEST(Binning, StreamMatchesInMemory)
+{
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<Vector2d> points(5000);
+    for (Vector2d &p : points)
+        p = Vector2d(dist(gen), dist(gen));
+
+    const AABB2d bounds(Vector2d(-1, -1), Vector2d(1, 1));
+    Binning::Histogram2<double> inMemory(bounds, 16, 16), streamed(bounds, 16, 16);
+    inMemory.add(points);
+
+    std::stringstream ss(Serial::format(std::span<const Vector2d>(points), Serial::Format::CSV));
+    EXPECT_EQ(streamed.addFrom(ss, Binning::Splat::Nearest, 97), points.size());
+
+    Binning::Histogram2<double> merged(bounds, 16, 16);
+    merged.merge(streamed);
+    for (std::size_t i = 0; i < inMemory.getCells().size(); i++)
+        EXPECT_EQ(merged.getCells()[i], inMemory.getCells()[i]);
+    EXPECT_THROW(merged.merge(Binning::Histogram2<double>(bounds, 8, 16)), std::runtime_error);
+}
+
+#ifdef VECTOR2_DISPATCH
+TEST(Dispatch, IsaNames)
+{
+    for (Dispatch::IsaLevel level : {Dispatch::IsaLevel::Baseline, Dispatch::IsaLevel::X86_64_v3, Dispatch::IsaLevel::X86_64_v4})
+        EXPECT_EQ(Dispatch::parseIsa(Dispatch::isaName(level)), level);
+    EXPECT_EQ(Dispatch::parseIsa("v3"), Dispatch::IsaLevel::X86_64_v3);
+    EXPECT_FALSE(Dispatch::parseIsa("sse9").has_value());
+    EXPECT_EQ(Dispatch::selectIsa("baseline", Dispatch::IsaLevel::X86_64_v4), Dispatch::IsaLevel::Baseline);
+    EXPECT_EQ(Dispatch::selectIsa("v4", Dispatch::IsaLevel::X86_64_v3), Dispatch::IsaLevel::X86_64_v3);
+    EXPECT_THROW((void)Dispatch::selectIsa("x86-64-v5", Dispatch::IsaLevel::X86_64_v4), std::runtime_error);
+    EXPECT_LE(Dispatch::activeIsa(), Dispatch::detectIsa());
+    EXPECT_EQ(Dispatch::kernels().level, Dispatch::activeIsa());
+}
+
+TEST(Dispatch, KernelsMatchGeneric)
+{
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    std::vector<float> state[6];
+    for (auto &v : state)
+        for (int i = 0; i < 1003; i++)
+            v.push_back(dist(gen));
+
+    auto run = [&](auto kernel, auto... args)
+    {
+        auto s = state;
+        kernel(s[0].data(), s[1].data(), s[2].data(), s[3].data(), s[4].data(), s[5].data(), 0, s[0].size(), args...);
+        return s;
+    };
+
+    std::vector<Vector2f> points;
+    for (std::size_t i = 0; i < state[0].size(); i++)
+        points.emplace_back(state[0][i], state[1][i]);
+
+    const auto expected = run(Integrate::detail::eulerKernel<true, float>, 0.1f, 0.9f, 5.0f);
+    const auto expectedSemi = run(Integrate::detail::semiImplicitEulerKernel<false, float>, 0.1f, 1.0f, 0.0f);
+    for (int l = 0; l <= int(Dispatch::detectIsa()); l++)
+    {
+        const Dispatch::KernelTable &table = Dispatch::kernels(Dispatch::IsaLevel(l));
+        EXPECT_EQ(int(table.level), l);
+        const auto actual = run(table.eulerClamped, 0.1f, 0.9f, 5.0f);
+        const auto actualSemi = run(table.semiImplicitEuler, 0.1f, 1.0f, 0.0f);
+
+        std::vector<std::uint32_t> cells(points.size()), expectedCells(points.size());
+        table.cellIndices(points.data(), cells.data(), 0, points.size(), -8.0f, -8.0f, 2.0f, 1.5f, 31.0f, 23.0f, 32);
+        Binning::detail::cellIndexKernel<float>(points.data(), expectedCells.data(), 0, points.size(), -8.0f, -8.0f, 2.0f, 1.5f, 31.0f, 23.0f, 32);
+        EXPECT_EQ(cells, expectedCells);
+        for (int k = 0; k < 4; k++)
+            for (std::size_t i = 0; i < expected[k].size(); i++)
+            {
+                EXPECT_NEAR(actual[k][i], expected[k][i], 1e-4f);
+                EXPECT_NEAR(actualSemi[k][i], expectedSemi[k][i], 1e-4f);
+            }
+    }
+
+    if (Dispatch::detectIsa() != Dispatch::IsaLevel::X86_64_v4)
+    {
+        EXPECT_THROW((void)Dispatch::kernels(Dispatch::IsaLevel::X86_64_v4), std::runtime_error);
+    }
+}
+#endif
+
 int main(int argc, char *argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);